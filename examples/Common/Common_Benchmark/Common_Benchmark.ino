@@ -0,0 +1,314 @@
+///
+/// @file Common_Benchmark.ino
+/// @brief Benchmark of the graphics primitives
+///
+/// @details Project Pervasive Displays Library Suite
+/// @n Based on highView technology
+///
+/// @n For each orientation and each primitive, report
+/// * ns per call
+/// * black pixels drawn per call and ns per pixel
+/// * calls to s_setPoint() per call
+///
+/// @n On the host back-end, the benchmark covers the three touch geometries
+/// 264x176, 392x456 and 416x240
+/// @code
+/// g++ -std=gnu++17 -O2 -DhV_HAL_HOST -Isrc -x c++ examples/Common/Common_Benchmark/Common_Benchmark.ino -x none src/*.cpp -o Common_Benchmark
+/// ./Common_Benchmark
+/// @endcode
+///
+/// @author Rei Vilo
+/// @date 21 Feb 2025
+/// @version 820
+///
+/// @copyright (c) Rei Vilo, 2010-2025
+/// @copyright Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+/// @copyright For exclusive use with Pervasive Displays screens
+///
+/// @see ReadMe.md for references
+/// @n
+///
+/// Release 820: First release
+///
+
+// Screen
+#include "PDLS_EXT3_Basic_Touch.h"
+
+// SDK
+// #include <Arduino.h>
+#include "hV_HAL_Peripherals.h"
+
+// Include application, user and local libraries
+// #include <SPI.h>
+
+// Configuration
+#include "hV_Configuration.h"
+
+// Set parameters
+#if defined(hV_HAL_HOST)
+#define BENCHMARK_REPEAT 200 ///< Calls per primitive
+#else
+#define BENCHMARK_REPEAT 8 ///< Calls per primitive
+#endif // hV_HAL_HOST
+
+// Define structures and classes
+
+// Define constants and variables
+#if defined(hV_HAL_HOST)
+
+Screen_EPD_EXT3_Fast myScreen271(eScreen_EPD_271_KS_09_Touch, boardRaspberryPiPico_RP2040);
+Screen_EPD_EXT3_Fast myScreen343(eScreen_EPD_343_PS_0B_Touch, boardRaspberryPiPico_RP2040);
+Screen_EPD_EXT3_Fast myScreen370(eScreen_EPD_370_PS_0C_Touch, boardRaspberryPiPico_RP2040);
+
+Screen_EPD_EXT3_Fast * myScreens[] = { &myScreen271, &myScreen343, &myScreen370 };
+
+#else
+
+Screen_EPD_EXT3_Fast myScreen(eScreen_EPD_370_PS_0C_Touch, boardRaspberryPiPico_RP2040);
+
+Screen_EPD_EXT3_Fast * myScreens[] = { &myScreen };
+
+#endif // hV_HAL_HOST
+
+const uint8_t numberScreens = sizeof(myScreens) / sizeof(myScreens[0]);
+
+const char * namePrimitives[] =
+{
+    "point",
+    "line",
+    "dLine-H",
+    "dLine-V",
+    "rectangle",
+    "dRectangle",
+    "circle",
+    "circle-solid",
+    "triangle",
+    "triangle-solid",
+    "gText",
+    "gTextLarge",
+    "ellipse",
+    "ellipse-solid",
+    "gTextLarge-x4",
+    "drawBitmap",
+};
+
+const uint8_t numberPrimitives = sizeof(namePrimitives) / sizeof(namePrimitives[0]);
+
+uint8_t bitmapStripes[64 * 8]; ///< 64 x 64 points, diagonal stripes
+
+// Prototypes
+
+// Utilities
+
+// Functions
+///
+/// @brief Draw one primitive
+/// @param screen screen
+/// @param primitive index of the primitive
+///
+void drawPrimitive(Screen_EPD_EXT3_Fast * screen, uint8_t primitive)
+{
+    uint16_t x = screen->screenSizeX();
+    uint16_t y = screen->screenSizeY();
+    uint16_t z = min(x, y);
+
+    switch (primitive)
+    {
+        case 0: // point
+
+            screen->point(x / 2, y / 2, myColours.black);
+            break;
+
+        case 1: // line, diagonal
+
+            screen->line(0, 0, x - 1, y - 1, myColours.black);
+            break;
+
+        case 2: // dLine, horizontal
+
+            screen->dLine(0, y / 2, x, 1, myColours.black);
+            break;
+
+        case 3: // dLine, vertical
+
+            screen->dLine(x / 2, 0, 1, y, myColours.black);
+            break;
+
+        case 4: // rectangle, outline
+
+            screen->setPenSolid(false);
+            screen->rectangle(x / 8, y / 8, x * 7 / 8, y * 7 / 8, myColours.black);
+            break;
+
+        case 5: // dRectangle, solid
+
+            screen->setPenSolid(true);
+            screen->dRectangle(x / 8, y / 8, x * 3 / 4, y * 3 / 4, myColours.black);
+            screen->setPenSolid(false);
+            break;
+
+        case 6: // circle, outline
+
+            screen->setPenSolid(false);
+            screen->circle(x / 2, y / 2, z / 3, myColours.black);
+            break;
+
+        case 7: // circle, solid
+
+            screen->setPenSolid(true);
+            screen->circle(x / 2, y / 2, z / 3, myColours.black);
+            screen->setPenSolid(false);
+            break;
+
+        case 8: // triangle, outline
+
+            screen->setPenSolid(false);
+            screen->triangle(0, 0, x - 1, y / 2, x / 4, y - 1, myColours.black);
+            break;
+
+        case 9: // triangle, solid
+
+            screen->setPenSolid(true);
+            screen->triangle(0, 0, x - 1, y / 2, x / 4, y - 1, myColours.black);
+            screen->setPenSolid(false);
+            break;
+
+        case 10: // gText
+
+            screen->selectFont(Font_Terminal8x12);
+            screen->gText(0, 0, "The quick brown fox jumps", myColours.black);
+            break;
+
+        case 11: // gTextLarge
+
+            screen->selectFont(Font_Terminal12x16);
+            screen->gTextLarge(0, 0, "12:34", myColours.black);
+            break;
+
+        case 12: // ellipse, outline
+
+            screen->setPenSolid(false);
+            screen->ellipse(x / 2, y / 2, x / 3, y / 4, myColours.black);
+            break;
+
+        case 13: // ellipse, solid
+
+            screen->setPenSolid(true);
+            screen->ellipse(x / 2, y / 2, x / 3, y / 4, myColours.black);
+            screen->setPenSolid(false);
+            break;
+
+        case 14: // gTextLarge, scale 4
+
+            screen->selectFont(Font_Terminal12x16);
+            screen->gTextLarge(0, 0, "12", myColours.black, myColours.white, 4);
+            break;
+
+        case 15: // drawBitmap, 64 x 64, unaligned
+
+            screen->drawBitmap(3, 5, bitmapStripes, 64, 64, BITMAP_COPY);
+            break;
+
+        default:
+
+            break;
+    }
+}
+
+///
+/// @brief Count black pixels
+/// @param screen screen
+/// @return number of black pixels in the frame-buffer
+///
+uint32_t countBlackPixels(Screen_EPD_EXT3_Fast * screen)
+{
+    uint32_t result = 0;
+
+    for (uint16_t x = 0; x < screen->screenSizeX(); x += 1)
+    {
+        for (uint16_t y = 0; y < screen->screenSizeY(); y += 1)
+        {
+            if (screen->readPoint(x, y) == myColours.black)
+            {
+                result += 1;
+            }
+        }
+    }
+
+    return result;
+}
+
+///
+/// @brief Perform the benchmark for one screen
+/// @param screen screen
+///
+void performBenchmark(Screen_EPD_EXT3_Fast * screen)
+{
+    screen->begin();
+
+    for (uint8_t orientation = 0; orientation < 4; orientation += 1)
+    {
+        screen->setOrientation(orientation);
+
+        for (uint8_t primitive = 0; primitive < numberPrimitives; primitive += 1)
+        {
+            // Pixels drawn by one call
+            screen->clear();
+            screen->resetCountSetPoint();
+            drawPrimitive(screen, primitive);
+            uint32_t countSetPoint = screen->getCountSetPoint();
+            uint32_t countPixels = countBlackPixels(screen);
+
+            // Time
+            uint32_t chrono = micros();
+            for (uint16_t index = 0; index < BENCHMARK_REPEAT; index += 1)
+            {
+                drawPrimitive(screen, primitive);
+            }
+            chrono = micros() - chrono;
+
+            uint32_t nsPerCall = (uint32_t)((uint64_t)chrono * 1000 / BENCHMARK_REPEAT);
+            uint32_t nsPerPixel = (countPixels > 0) ? nsPerCall / countPixels : 0;
+
+            mySerial.println(formatString("%ix%i,%i,%s,%i,%i,%i,%i", screen->screenSizeX(), screen->screenSizeY(), orientation, namePrimitives[primitive], nsPerCall, countPixels, nsPerPixel, countSetPoint));
+        }
+    }
+}
+
+// Add setup code
+///
+/// @brief Setup
+///
+void setup()
+{
+    mySerial.begin(115200);
+    delay(500);
+    mySerial.println();
+    mySerial.println("=== " __FILE__);
+    mySerial.println("=== " __DATE__ " " __TIME__);
+    mySerial.println();
+
+    for (uint16_t index = 0; index < sizeof(bitmapStripes); index += 1)
+    {
+        bitmapStripes[index] = 0xf0 >> ((index / 8) % 8) | 0xf0 << (8 - (index / 8) % 8);
+    }
+
+    mySerial.println("screen,orientation,primitive,ns/call,pixels/call,ns/pixel,setPoint/call");
+
+    for (uint8_t index = 0; index < numberScreens; index += 1)
+    {
+        performBenchmark(myScreens[index]);
+    }
+
+    mySerial.println("=== ");
+    mySerial.println();
+}
+
+// Add loop code
+///
+/// @brief Loop, empty
+///
+void loop()
+{
+    delay(1000);
+}
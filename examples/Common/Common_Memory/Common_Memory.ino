@@ -0,0 +1,139 @@
+///
+/// @file Common_Memory.ino
+/// @brief Memory footprint with budget
+///
+/// @details Project Pervasive Displays Library Suite
+/// @n Based on highView technology
+///
+/// @n Report the memory footprint for the selected screen,
+/// and check the RAM total against MEMORY_BUDGET.
+/// @n The constant font tables are reported apart, as they sit in flash on most MCUs.
+///
+/// @n On the host back-end, the check covers the three touch screens
+/// and the program exits with code 1 when the RAM total exceeds the budget
+/// @code
+/// g++ -std=gnu++17 -DhV_HAL_HOST -DMEMORY_BUDGET=81920 -Isrc -x c++ examples/Common/Common_Memory/Common_Memory.ino -x none src/*.cpp -o Common_Memory
+/// ./Common_Memory
+/// @endcode
+///
+/// @author Rei Vilo
+/// @date 21 Feb 2025
+/// @version 820
+///
+/// @copyright (c) Rei Vilo, 2010-2025
+/// @copyright Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+/// @copyright For exclusive use with Pervasive Displays screens
+///
+/// @see ReadMe.md for references
+/// @n
+///
+/// Release 820: First release
+///
+
+// Screen
+#include "PDLS_EXT3_Basic_Touch.h"
+
+// SDK
+// #include <Arduino.h>
+#include "hV_HAL_Peripherals.h"
+
+// Include application, user and local libraries
+// #include <SPI.h>
+
+// Configuration
+#include "hV_Configuration.h"
+
+// Set parameters
+#ifndef MEMORY_BUDGET
+#define MEMORY_BUDGET 81920 ///< RAM budget in bytes, 80 kB
+#endif // MEMORY_BUDGET
+
+// Define structures and classes
+
+// Define constants and variables
+#if defined(hV_HAL_HOST)
+
+Screen_EPD_EXT3_Fast myScreen271(eScreen_EPD_271_KS_09_Touch, boardRaspberryPiPico_RP2040);
+Screen_EPD_EXT3_Fast myScreen343(eScreen_EPD_343_PS_0B_Touch, boardRaspberryPiPico_RP2040);
+Screen_EPD_EXT3_Fast myScreen370(eScreen_EPD_370_PS_0C_Touch, boardRaspberryPiPico_RP2040);
+
+Screen_EPD_EXT3_Fast * myScreens[] = { &myScreen271, &myScreen343, &myScreen370 };
+
+#else
+
+Screen_EPD_EXT3_Fast myScreen(eScreen_EPD_370_PS_0C_Touch, boardRaspberryPiPico_RP2040);
+
+Screen_EPD_EXT3_Fast * myScreens[] = { &myScreen };
+
+#endif // hV_HAL_HOST
+
+const uint8_t numberScreens = sizeof(myScreens) / sizeof(myScreens[0]);
+
+// Prototypes
+
+// Utilities
+
+// Functions
+///
+/// @brief Report the memory footprint
+/// @param screen screen
+/// @return true if within budget, false otherwise
+///
+bool reportMemory(Screen_EPD_EXT3_Fast * screen)
+{
+    screen->begin();
+    memory_t memory = screen->getMemoryFootprint();
+    bool flagResult = (memory.RAM <= MEMORY_BUDGET);
+
+    mySerial.println(formatString("%s %ix%i", screen->WhoAmI().c_str(), screen->screenSizeX(), screen->screenSizeY()));
+    mySerial.println(formatString("%16s %8i bytes, heap", "frame-buffer", memory.frameBuffer));
+    mySerial.println(formatString("%16s %8i bytes, heap, from first text", "glyph cache", memory.glyphCache));
+    mySerial.println(formatString("%16s %8i bytes, static, OTP %i", "object", memory.object, memory.OTP));
+    mySerial.println(formatString("%16s %8i bytes, static", "buffers", memory.buffers));
+    mySerial.println(formatString("%16s %8i bytes, budget %i %s", "RAM", memory.RAM, MEMORY_BUDGET, flagResult ? "passed" : "exceeded"));
+    mySerial.println(formatString("%16s %8i bytes, constant", "fonts", memory.fonts));
+    mySerial.println(formatString("%16s %8i bytes, constant, not budgeted", "flash", memory.flash));
+    mySerial.println();
+
+    return flagResult;
+}
+
+// Add setup code
+///
+/// @brief Setup
+///
+void setup()
+{
+    mySerial.begin(115200);
+    delay(500);
+    mySerial.println();
+    mySerial.println("=== " __FILE__);
+    mySerial.println("=== " __DATE__ " " __TIME__);
+    mySerial.println();
+
+    bool flagResult = true;
+    for (uint8_t index = 0; index < numberScreens; index += 1)
+    {
+        flagResult &= reportMemory(myScreens[index]);
+    }
+
+    mySerial.println(flagResult ? "Memory budget passed" : "Memory budget exceeded");
+
+#if defined(hV_HAL_HOST)
+
+    hV_HAL_Host_setExitCode(flagResult ? 0 : 1);
+
+#endif // hV_HAL_HOST
+
+    mySerial.println("=== ");
+    mySerial.println();
+}
+
+// Add loop code
+///
+/// @brief Loop, empty
+///
+void loop()
+{
+    delay(1000);
+}
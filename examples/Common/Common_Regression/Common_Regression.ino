@@ -0,0 +1,722 @@
+///
+/// @file Common_Regression.ino
+/// @brief Golden-frame regression and performance harness
+///
+/// @details Project Pervasive Displays Library Suite
+/// @n Based on highView technology
+///
+/// @n Scenarios are taken from the examples Common_Forms, Common_Text, Common_Fonts,
+/// Fast_Orientation and Basic_Touch_TicTacToe, with the touch moves replaced by a fixed game,
+/// plus large text at scales 2 to 8 and bitmaps with raster operations.
+/// @n For each frame, the harness records
+/// * the hash of the frame-buffer after the drawing, see getFrameHash()
+/// * the time spent drawing the frame since the previous flush, in us
+///
+/// @n On the host back-end, the harness covers the three touch screens and compares
+/// each frame against the reference file Common_Regression.csv next to the sketch
+/// * a different hash fails the run
+/// * a time above reference + REGRESSION_THRESHOLD % and above reference + REGRESSION_MARGIN us
+/// is reported as slower, for information only
+/// @n The program exits with code 1 on failure
+/// @n The reference times are host microseconds recorded with -O2 on one machine.
+/// Build with -DREGRESSION_STRICT=1 to fail on slower frames too, on a quiet machine;
+/// the scenarios then run REGRESSION_RUNS times and the minimum time of each frame is checked.
+/// @n On the boards, the harness only reports the frames.
+/// @n The path of the reference file comes from __FILE__, so build with the absolute path
+/// of the sketch to run from any directory, or define REGRESSION_REFERENCE.
+/// @code
+/// g++ -std=gnu++17 -O2 -DhV_HAL_HOST -Isrc -x c++ $PWD/examples/Common/Common_Regression/Common_Regression.ino -x none src/*.cpp -o Common_Regression
+/// ./Common_Regression
+/// @endcode
+/// @n Build with -DREGRESSION_RECORD=1 to write the reference file instead,
+/// only when a change of pixels is intended.
+///
+/// @author Rei Vilo
+/// @date 21 Feb 2025
+/// @version 820
+///
+/// @copyright (c) Rei Vilo, 2010-2025
+/// @copyright Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+/// @copyright For exclusive use with Pervasive Displays screens
+///
+/// @see ReadMe.md for references
+/// @n
+///
+/// Release 820: First release
+///
+
+// Screen
+#include "PDLS_EXT3_Basic_Touch.h"
+
+// SDK
+// #include <Arduino.h>
+#include "hV_HAL_Peripherals.h"
+
+// Include application, user and local libraries
+// #include <SPI.h>
+
+// Configuration
+#include "hV_Configuration.h"
+
+// Set parameters
+// #define REGRESSION_REFERENCE "Common_Regression.csv" ///< Reference file, default = sketch path with .csv
+
+#ifndef REGRESSION_RECORD
+#define REGRESSION_RECORD 0 ///< 1 = write the reference file, 0 = check against it
+#endif // REGRESSION_RECORD
+
+#ifndef REGRESSION_THRESHOLD
+#define REGRESSION_THRESHOLD 50 ///< Allowed increase of time, %
+#endif // REGRESSION_THRESHOLD
+
+#ifndef REGRESSION_MARGIN
+#define REGRESSION_MARGIN 500 ///< Allowed increase of time, us, for short frames
+#endif // REGRESSION_MARGIN
+
+#ifndef REGRESSION_STRICT
+#define REGRESSION_STRICT 0 ///< 1 = slower frames fail the run, 0 = reported only
+#endif // REGRESSION_STRICT
+
+#ifndef REGRESSION_RUNS
+#if (REGRESSION_STRICT == 1)
+#define REGRESSION_RUNS 5 ///< Number of runs, minimum time is checked
+#else
+#define REGRESSION_RUNS 1 ///< Number of runs, minimum time is checked
+#endif // REGRESSION_STRICT
+#endif // REGRESSION_RUNS
+
+#define REGRESSION_FRAMES 128 ///< Maximum number of frames in the reference
+
+#define PLAYER_NONE 0
+#define PLAYER_HUMAN 1
+#define PLAYER_MCU 2
+
+#define NUMBER 4
+
+// Define structures and classes
+///
+/// @brief Reference frame
+///
+struct frame_s
+{
+    char key[48]; ///< screen, scenario and frame number
+    uint32_t hash; ///< hash of the frame-buffer
+    uint32_t time; ///< drawing time in us
+    uint32_t best; ///< minimum drawing time of the runs in us
+};
+
+// Define constants and variables
+#if defined(hV_HAL_HOST)
+
+Screen_EPD_EXT3_Fast myScreen271(eScreen_EPD_271_KS_09_Touch, boardRaspberryPiPico_RP2040);
+Screen_EPD_EXT3_Fast myScreen343(eScreen_EPD_343_PS_0B_Touch, boardRaspberryPiPico_RP2040);
+Screen_EPD_EXT3_Fast myScreen370(eScreen_EPD_370_PS_0C_Touch, boardRaspberryPiPico_RP2040);
+
+Screen_EPD_EXT3_Fast * myScreens[] = { &myScreen271, &myScreen343, &myScreen370 };
+
+#else
+
+Screen_EPD_EXT3_Fast myScreen(eScreen_EPD_370_PS_0C_Touch, boardRaspberryPiPico_RP2040);
+
+Screen_EPD_EXT3_Fast * myScreens[] = { &myScreen };
+
+#endif // hV_HAL_HOST
+
+const uint8_t numberScreens = sizeof(myScreens) / sizeof(myScreens[0]);
+
+frame_s reference[REGRESSION_FRAMES];
+uint16_t numberReference = 0;
+
+const char * nameScenario = "";
+uint8_t numberFrame = 0;
+uint32_t chronoFrame = 0;
+uint16_t numberFailed = 0;
+uint16_t numberSlower = 0;
+uint8_t numberRun = 0;
+
+#if defined(hV_HAL_HOST)
+
+FILE * fileRecord = 0;
+char pathReference[256]; ///< Reference file, see setReferencePath()
+
+#endif // hV_HAL_HOST
+
+// Bitmap, ring of 21 x 21 points
+uint8_t bitmapRing[21 * 3];
+
+// TicTacToe
+uint16_t minX, maxX, minY, maxY, sizeTable, sizeCell;
+uint16_t colourHuman, colourMCU, colourGrid, colourBackground, colourMessage;
+
+// Prototypes
+
+// Utilities
+#if defined(hV_HAL_HOST)
+
+///
+/// @brief Set the path of the reference file
+/// @details REGRESSION_REFERENCE if defined, otherwise the path of the sketch
+/// with .csv instead of .ino
+///
+void setReferencePath()
+{
+#if defined(REGRESSION_REFERENCE)
+
+    snprintf(pathReference, sizeof(pathReference), "%s", REGRESSION_REFERENCE);
+
+#else
+
+    snprintf(pathReference, sizeof(pathReference), "%s", __FILE__);
+    char * extension = strrchr(pathReference, '.');
+    if ((extension != 0) and (strlen(extension) == 4))
+    {
+        strcpy(extension, ".csv");
+    }
+
+#endif // REGRESSION_REFERENCE
+}
+
+#endif // hV_HAL_HOST
+
+///
+/// @brief Load the reference file
+/// @return true if loaded, false otherwise
+///
+bool loadReference()
+{
+#if defined(hV_HAL_HOST)
+
+    FILE * file = fopen(pathReference, "r");
+    if (file == 0)
+    {
+        return false;
+    }
+
+    char line[96];
+    while ((fgets(line, sizeof(line), file) != 0) and (numberReference < REGRESSION_FRAMES))
+    {
+        frame_s & frame = reference[numberReference];
+        if (sscanf(line, "%47[^,],%x,%u", frame.key, &frame.hash, &frame.time) == 3)
+        {
+            frame.best = 0xffffffff;
+            numberReference += 1;
+        }
+    }
+    fclose(file);
+    return true;
+
+#else
+
+    return false;
+
+#endif // hV_HAL_HOST
+}
+
+///
+/// @brief Find a frame in the reference
+/// @param key screen, scenario and frame number
+/// @return pointer to the frame, 0 if not found
+///
+frame_s * findReference(const char * key)
+{
+    for (uint16_t index = 0; index < numberReference; index += 1)
+    {
+        if (strcmp(reference[index].key, key) == 0)
+        {
+            return &reference[index];
+        }
+    }
+    return 0;
+}
+
+///
+/// @brief Start a scenario
+/// @param name name of the scenario
+///
+void startScenario(const char * name)
+{
+    nameScenario = name;
+    numberFrame = 0;
+    chronoFrame = micros();
+}
+
+///
+/// @brief Flush the frame and check it against the reference
+/// @param screen screen
+///
+void flushFrame(Screen_EPD_EXT3_Fast * screen)
+{
+    uint32_t time = micros() - chronoFrame;
+    screen->flush();
+    uint32_t hash = screen->getFrameHash();
+
+    char key[48];
+    snprintf(key, sizeof(key), "%s/%s/%i", screen->screenNumber().c_str(), nameScenario, numberFrame);
+
+    const char * status = "recorded";
+
+#if (REGRESSION_RECORD == 1)
+
+#if defined(hV_HAL_HOST)
+
+    if (fileRecord != 0)
+    {
+        fprintf(fileRecord, "%s,%08x,%u\n", key, hash, time);
+    }
+
+#endif // hV_HAL_HOST
+
+#elif defined(hV_HAL_HOST)
+
+    frame_s * frame = findReference(key);
+    if (frame == 0)
+    {
+        status = "missing";
+        numberFailed += 1;
+    }
+    else if (frame->hash != hash)
+    {
+        status = "mismatch";
+        numberFailed += 1;
+    }
+    else
+    {
+        // Minimum of the runs, checked on the last run only
+        frame->best = hV_HAL_min(frame->best, time);
+        time = frame->best;
+        if (numberRun + 1 < REGRESSION_RUNS)
+        {
+            status = 0; // silent
+        }
+        else if ((time > (uint32_t)((uint64_t)frame->time * (100 + REGRESSION_THRESHOLD) / 100)) and (time > frame->time + REGRESSION_MARGIN))
+        {
+            status = "slower";
+            numberSlower += 1;
+#if (REGRESSION_STRICT == 1)
+            numberFailed += 1;
+#endif // REGRESSION_STRICT
+        }
+        else
+        {
+            status = "passed";
+        }
+    }
+
+    if (status == 0)
+    {
+        numberFrame += 1;
+        chronoFrame = micros();
+        return;
+    }
+
+#endif // REGRESSION_RECORD
+
+    mySerial.println(formatString("%s,%08x,%i,%s", key, hash, time, status));
+
+    numberFrame += 1;
+    chronoFrame = micros();
+}
+
+///
+/// @brief Display text centered on coordinates
+/// @param screen screen
+/// @param x0 x coordinate
+/// @param y0 y coordinate
+/// @param text text
+/// @param colour colour
+///
+void displayCenteredText(Screen_EPD_EXT3_Fast * screen, uint16_t x0, uint16_t y0, String text, uint16_t colour)
+{
+    uint16_t dz = screen->characterSizeY() / 2;
+    screen->setPenSolid(true);
+    screen->dRectangle(0, y0 - dz, screen->screenSizeX(), 2 * dz, colourBackground);
+
+    uint16_t dX = x0 - screen->stringSizeX(text) / 2;
+    uint16_t dY = y0 - screen->characterSizeY() / 2;
+    screen->gText(dX, dY, text, colour);
+}
+
+// Functions
+///
+/// @brief Scenario from Common_Forms
+/// @param screen screen
+///
+void scenarioForms(Screen_EPD_EXT3_Fast * screen)
+{
+    startScenario("forms");
+
+    screen->clear();
+    screen->setOrientation(7);
+
+    uint16_t x = screen->screenSizeX();
+    uint16_t y = screen->screenSizeY();
+    uint16_t z = hV_HAL_min(x, y);
+
+    screen->setPenSolid(false);
+    screen->dRectangle(0, 0, x, y, myColours.black);
+    screen->dLine(0, 0, x, y, myColours.red);
+
+    screen->setPenSolid(true);
+    screen->circle(x / 3, y / 3, z / 4, myColours.grey);
+    screen->triangle(x * 2 / 3, y / 3, x * 3 / 4, y * 2 / 3 - 10, x - 10, 10, myColours.black);
+    screen->dRectangle(x / 3, y * 2 / 3, x / 3, y / 4, myColours.red);
+    screen->setPenSolid(false);
+
+    flushFrame(screen);
+}
+
+///
+/// @brief Scenario from Common_Text
+/// @param screen screen
+///
+void scenarioText(Screen_EPD_EXT3_Fast * screen)
+{
+    startScenario("text");
+
+    screen->clear();
+    screen->setOrientation(7);
+    uint16_t x = screen->screenSizeX();
+    uint16_t y = screen->screenSizeY();
+
+    screen->selectFont(Font_Terminal8x12);
+
+    for (uint8_t i = 1; i < 17; i++)
+    {
+        screen->gText(i * x / 17, 0, formatString(".%x", (i - 1)), myColours.red);
+    }
+    for (uint8_t j = 2; j < 16; j++)
+    {
+        screen->gText(0, (j - 1) * y / 15, formatString("%x.", (j)), myColours.red);
+    }
+
+    for (uint16_t i = 1; i < 17; i++)
+    {
+        for (uint8_t j = 2; j < 16; j++)
+        {
+            uint8_t k = (i - 1) + j * 16;
+            String text = (String)char(k);
+            uint16_t dx = i * x / 17 + (x / 17 - screen->stringSizeX(text)) / 2;
+            screen->gText(dx, (j - 1) * y / 15, text, myColours.black);
+        }
+    }
+
+    flushFrame(screen);
+}
+
+///
+/// @brief Scenario from Common_Fonts
+/// @param screen screen
+///
+void scenarioFonts(Screen_EPD_EXT3_Fast * screen)
+{
+    startScenario("fonts");
+
+    screen->clear();
+    uint16_t y = 10;
+    screen->setOrientation(7);
+
+    screen->selectFont(Font_Terminal12x16);
+    screen->gText(10, y, screen->WhoAmI(), myColours.red);
+    y += screen->characterSizeY();
+    screen->gText(10, y, formatString("%i x %i", screen->screenSizeX(), screen->screenSizeY()), myColours.red);
+    y += screen->characterSizeY();
+    y += screen->characterSizeY();
+
+    screen->selectFont(Font_Terminal6x8);
+    screen->gText(10, y, "Terminal6x8");
+    y += screen->characterSizeY();
+
+    screen->selectFont(Font_Terminal8x12);
+    screen->gText(10, y, "Terminal8x12");
+    y += screen->characterSizeY();
+
+    screen->selectFont(Font_Terminal12x16);
+    screen->gText(10, y, "Terminal12x16");
+    y += screen->characterSizeY();
+
+    screen->selectFont(Font_Terminal16x24);
+    screen->gText(10, y, "Terminal16x24");
+
+    flushFrame(screen);
+}
+
+///
+/// @brief Scenario from Fast_Orientation
+/// @param screen screen
+///
+void scenarioOrientation(Screen_EPD_EXT3_Fast * screen)
+{
+    startScenario("orientation");
+
+    screen->clear();
+    screen->selectFont(2);
+
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        screen->setOrientation(i);
+        screen->gText(4, 4, formatString("> Orientation %i", i));
+        flushFrame(screen);
+    }
+}
+
+///
+/// @brief Scenario with large text, scales 2 to 8
+/// @param screen screen
+///
+void scenarioLarge(Screen_EPD_EXT3_Fast * screen)
+{
+    startScenario("large");
+
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        screen->clear();
+        screen->setOrientation(i);
+
+        screen->selectFont(Font_Terminal8x12);
+        screen->gTextLarge(4, 4, "12:34", myColours.black, myColours.white, 2 + i);
+
+        screen->selectFont(Font_Terminal6x8);
+        screen->setFontSolid(true);
+        screen->gTextLarge(4, screen->screenSizeY() / 2, "56", myColours.black, myColours.grey, 5 + i);
+        screen->setFontSolid(false);
+        flushFrame(screen);
+    }
+}
+
+///
+/// @brief Scenario with bitmaps, raster operations and clip
+/// @param screen screen
+///
+void scenarioBitmap(Screen_EPD_EXT3_Fast * screen)
+{
+    startScenario("bitmap");
+
+    memset(bitmapRing, 0x00, sizeof(bitmapRing));
+    for (int16_t y = 0; y < 21; y += 1)
+    {
+        for (int16_t x = 0; x < 21; x += 1)
+        {
+            int16_t d = (x - 10) * (x - 10) + (y - 10) * (y - 10);
+            if ((d >= 36) and (d <= 100))
+            {
+                bitSet(bitmapRing[y * 3 + x / 8], 7 - x % 8);
+            }
+        }
+    }
+
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        screen->clear();
+        screen->setOrientation(i);
+
+        screen->setPenSolid(true);
+        screen->dRectangle(0, 40, screen->screenSizeX(), 30, myColours.grey);
+        screen->setPenSolid(false);
+
+        for (uint8_t operation = BITMAP_COPY; operation <= BITMAP_NOT; operation += 1)
+        {
+            uint16_t x = 3 + operation * 29;
+            screen->drawBitmap(x, 3 + operation, bitmapRing, 21, 21, operation);
+            screen->drawBitmap(x + operation, 45, bitmapRing, 21, 21, operation);
+        }
+
+        // Clipped, partly outside the screen
+        screen->pushClip(0, 80, screen->screenSizeX() / 2, 120);
+        screen->drawBitmap(screen->screenSizeX() / 2 - 10, 75, bitmapRing, 21, 21, BITMAP_XOR);
+        screen->drawBitmap((uint16_t)(-7), 90, bitmapRing, 21, 21, BITMAP_COPY);
+        screen->popClip();
+
+        flushFrame(screen);
+    }
+}
+
+///
+/// @brief Scenario from Basic_Touch_TicTacToe
+/// @param screen screen
+/// @note Fixed game, human wins on second column
+///
+void scenarioTicTacToe(Screen_EPD_EXT3_Fast * screen)
+{
+    startScenario("tictactoe");
+
+    screen->setOrientation(ORIENTATION_PORTRAIT);
+    screen->selectFont(Font_Terminal12x16);
+
+    minX = 0;
+    maxX = screen->screenSizeX();
+    minY = 0;
+    maxY = screen->screenSizeY();
+
+    sizeTable = hV_HAL_min(maxX - minX, maxY - minY);
+    sizeCell = sizeTable / NUMBER;
+
+    uint16_t w;
+    w = (maxX - minX - NUMBER * sizeCell) / 2;
+    minX += w;
+    maxX -= w;
+    w = (maxY - minY - NUMBER * sizeCell) / 2;
+    minY += w;
+    maxY -= w;
+
+    colourHuman = myColours.black;
+    colourMCU = myColours.grey;
+    colourGrid = myColours.grey;
+    colourBackground = myColours.white;
+    colourMessage = myColours.black;
+
+    // Start screen
+    screen->clear(colourBackground);
+    screen->rectangle(minX, minY, maxX, maxY, colourGrid);
+    displayCenteredText(screen, minX + sizeTable / 2, minY + sizeTable * 1 / 4, "Tic Tac Toe", colourMessage);
+    displayCenteredText(screen, minX + sizeTable / 2, minY + sizeTable * 3 / 4, "Touch to start", colourMessage);
+    flushFrame(screen);
+
+    // Game screen
+    screen->clear(colourBackground);
+    for (uint8_t i = 0; i <= NUMBER; i++)
+    {
+        uint16_t z = i * sizeCell;
+
+        screen->dLine(minX + z, minY + 0, 1, maxY - minY, colourGrid);
+        screen->dLine(minX + 0, minY + z, maxX - minX, 1, colourGrid);
+    }
+    flushFrame(screen);
+
+    // Moves, i then j, MCU first
+    const uint8_t moves[][2] = { { 0, 0 }, { 1, 1 }, { 3, 3 }, { 1, 2 }, { 0, 3 }, { 1, 0 }, { 0, 1 }, { 1, 3 } };
+    const uint8_t numberMoves = sizeof(moves) / sizeof(moves[0]);
+
+    for (uint8_t move = 0; move < numberMoves; move += 1)
+    {
+        uint8_t player = (move % 2 == 0) ? PLAYER_MCU : PLAYER_HUMAN;
+
+        displayCenteredText(screen, maxX / 2, maxY / 6, (player == PLAYER_MCU) ? "MCU plays" : "Human plays", colourMessage);
+        flushFrame(screen);
+
+        uint16_t x0 = minX + moves[move][0] * sizeCell;
+        uint16_t y0 = minY + moves[move][1] * sizeCell;
+        uint16_t dz = sizeCell / 2 - 8;
+
+        screen->setPenSolid(true);
+        if (player == PLAYER_MCU)
+        {
+            screen->circle(x0 + sizeCell / 2, y0 + sizeCell / 2, dz, colourMCU);
+        }
+        else
+        {
+            screen->dRectangle(x0 + 8, y0 + 8, sizeCell - 16, sizeCell - 16, colourHuman);
+        }
+        screen->setPenSolid(false);
+        flushFrame(screen);
+    }
+
+    // Game over screen
+    screen->clear(colourBackground);
+    screen->rectangle(minX, minY, maxX, maxY, colourGrid);
+    displayCenteredText(screen, minX + sizeTable / 2, minY + sizeTable * 3 / 4, "HUMAN WINS", colourHuman);
+    displayCenteredText(screen, minX + sizeTable / 2, minY + sizeTable * 1 / 4, "GAME OVER", colourMessage);
+    displayCenteredText(screen, minX + sizeTable / 2, minY + sizeTable * 2 / 4, "Touch to start", colourMessage);
+    flushFrame(screen);
+}
+
+///
+/// @brief Perform all the scenarios for one screen
+/// @param screen screen
+///
+void performRegression(Screen_EPD_EXT3_Fast * screen)
+{
+    screen->begin();
+
+    scenarioForms(screen);
+    scenarioText(screen);
+    scenarioFonts(screen);
+    scenarioOrientation(screen);
+    scenarioLarge(screen);
+    scenarioBitmap(screen);
+    scenarioTicTacToe(screen);
+}
+
+// Add setup code
+///
+/// @brief Setup
+///
+void setup()
+{
+    mySerial.begin(115200);
+    delay(500);
+    mySerial.println();
+    mySerial.println("=== " __FILE__);
+    mySerial.println("=== " __DATE__ " " __TIME__);
+    mySerial.println();
+
+#if defined(hV_HAL_HOST)
+
+    setReferencePath();
+
+#endif // hV_HAL_HOST
+
+#if (REGRESSION_RECORD == 1)
+
+#if defined(hV_HAL_HOST)
+
+    fileRecord = fopen(pathReference, "w");
+    if (fileRecord == 0)
+    {
+        mySerial.println(formatString("Reference %s not writable", pathReference));
+        numberFailed += 1;
+    }
+
+#endif // hV_HAL_HOST
+
+#elif defined(hV_HAL_HOST)
+
+    if (loadReference() == false)
+    {
+        mySerial.println(formatString("Reference %s not found", pathReference));
+    }
+
+#endif // REGRESSION_RECORD
+
+    mySerial.println("screen/scenario/frame,hash,us,status");
+
+    for (uint8_t index = 0; index < numberScreens; index += 1)
+    {
+#if (REGRESSION_RECORD == 1)
+
+        performRegression(myScreens[index]);
+
+#else
+
+        for (numberRun = 0; numberRun < REGRESSION_RUNS; numberRun += 1)
+        {
+            performRegression(myScreens[index]);
+        }
+
+#endif // REGRESSION_RECORD
+    }
+
+#if defined(hV_HAL_HOST)
+
+    if (fileRecord != 0)
+    {
+        fclose(fileRecord);
+    }
+
+    hV_HAL_Host_setExitCode((numberFailed > 0) ? 1 : 0);
+
+#endif // hV_HAL_HOST
+
+    mySerial.println(formatString("Regression %s, %i failed, %i slower", (numberFailed > 0) ? "failed" : "passed", numberFailed, numberSlower));
+
+    mySerial.println("=== ");
+    mySerial.println();
+}
+
+// Add loop code
+///
+/// @brief Loop, empty
+///
+void loop()
+{
+    delay(1000);
+}
@@ -41,6 +41,7 @@
 
 // Set parameters
 #define DISPLAY_WHOAMI 1
+#define DISPLAY_PROFILE 1
 
 // Define structures and classes
 
@@ -67,6 +68,34 @@ void wait(uint8_t second)
 
 // Functions
 
+#if (DISPLAY_PROFILE == 1)
+
+///
+/// @brief Profile of begin()
+///
+void displayProfile()
+{
+    const char * nameStages[STAGE_NUMBER] =
+    {
+        "configuration",
+        "report",
+        "frame-buffer",
+        "reset",
+        "OTP",
+        "SPI",
+        "fonts",
+        "touch",
+        "begin",
+    };
+
+    for (uint8_t stage = 0; stage < STAGE_NUMBER; stage += 1)
+    {
+        mySerial.println(formatString("%16s %8i us", nameStages[stage], myScreen.getBeginProfile(stage)));
+    }
+}
+
+#endif // DISPLAY_PROFILE
+
 #if (DISPLAY_WHOAMI == 1)
 
 ///
@@ -135,6 +164,13 @@ void setup()
     myScreen.begin();
     mySerial.println(formatString("%s %ix%i", myScreen.WhoAmI().c_str(), myScreen.screenSizeX(), myScreen.screenSizeY()));
 
+#if (DISPLAY_PROFILE == 1)
+
+    mySerial.println("DISPLAY_PROFILE");
+    displayProfile();
+
+#endif // DISPLAY_PROFILE
+
 #if (DISPLAY_WHOAMI == 1)
 
     mySerial.println("DISPLAY_WHOAMI");
@@ -28,6 +28,8 @@
 /// Release 542: First release
 /// Release 604: Global and fast variants
 /// Release 702: Added xE2150KS0Jx and xE2152KS0Jx
+/// Release 820: Added statistics for phases of flush
+/// Release 820: Added SPI counters
 ///
 
 // Screen
@@ -68,6 +70,25 @@ void wait(uint8_t second)
 }
 
 // Functions
+///
+/// @brief Display statistics for phases of flush and SPI counters for last flush
+///
+void displayStatistics()
+{
+    const char * namePhases[PHASE_NUMBER] = { "resume", "initial", "sendImageData", "update", "powerOff", "waitBusy", "flush" };
+
+    for (uint8_t phase = 0; phase < PHASE_NUMBER; phase += 1)
+    {
+        statistics_t statistics = myScreen.getFlushStatistics(phase);
+        mySerial.println(formatString("%16s count= %i min= %i max= %i mean= %i us", namePhases[phase], statistics.count, statistics.minimum, statistics.maximum, statistics.mean));
+    }
+
+    counters_t counters = myScreen.getBoardCounters();
+    mySerial.println(formatString("%16s command= %i data= %i bytes", "SPI", counters.commandBytes, counters.dataBytes));
+    mySerial.println(formatString("%16s CS= %i DC= %i transitions", "SPI", counters.transitionsCS, counters.transitionsDC));
+    mySerial.println(formatString("%16s delayCS= %i guardCSS= %i us", "SPI", counters.timeDelayCS, counters.timeGuardCSS));
+}
+
 ///
 /// @brief Perform the speed test
 ///
@@ -109,6 +130,8 @@ void performTest()
     myScreen.dRectangle(0, dz * 1, x, dz, myColours.black);
 
     myScreen.flush();
+
+    displayStatistics();
 }
 
 // Add setup code
@@ -41,11 +41,40 @@
 // Release 804: Improved power management
 // Release 805: Improved stability
 // Release 806: New library for Wide temperature only
+// Release 820: Added emulated panel for host back-end
+// Release 820: Added statistics for benchmark
+// Release 820: Added statistics for phases of flush
+// Release 820: Added SPI counters per flush
+// Release 820: Added memory footprint
+// Release 820: Added profile of begin()
+// Release 820: Added frame hash for regression
+// Release 820: Added frame-buffer export and import
+// Release 820: Added trace points
+// Release 820: Added fill of rectangle with byte spans
+// Release 820: Added oriented writer set by s_setOrientation()
+// Release 820: Added column fill with constant stride
+// Release 820: Added byte blitter for characters
+// Release 820: Added cache of rotated characters
+// Release 820: Added scaled characters for gTextLarge()
+// Release 820: Added clip rectangle for points, fills and characters
+// Release 820: Added bitmap blitter with raster operations
+// Release 820: Added dirty band to copy only the changed lines after flush
+// Release 820: Added skip of flush for unchanged frame
+// Release 820: Added dirty region with logical and physical bounding box
+// Release 820: Added fast update of a region for medium screens
+// Release 820: Added asynchronous flush with polling
 //
 
 // Library header
 #include "Screen_EPD_EXT3.h"
 
+#if defined(hV_HAL_HOST)
+
+// Emulated panel
+#include "hV_HAL_Host_Panel.h"
+
+#endif // hV_HAL_HOST
+
 //
 // === COG section
 //
@@ -59,6 +88,9 @@
 /// * ApplicationNote_152_Size_wide-Temperature_EPD_v01_20231225_A
 //
 
+// No wait for busy, see s_waitFlushBusy()
+#define FLUSH_BUSY_NONE 0xff
+
 //
 // === Touch section
 //
@@ -177,6 +209,12 @@ void Screen_EPD_EXT3_Fast::COG_MediumKP_sendImageData(uint8_t updateMode)
     FRAMEBUFFER_TYPE nextBuffer = s_newImage;
     FRAMEBUFFER_TYPE previousBuffer = s_newImage + u_pageColourSize;
 
+    if (s_windowLine1 <= s_windowLine2)
+    {
+        COG_MediumKP_sendImageWindow(updateMode);
+        return;
+    }
+
     // Send image data
     b_sendIndexData(0x13, &COG_data[0x15], 6); // DUW
     b_sendIndexData(0x90, &COG_data[0x0c], 4); // DRFW
@@ -207,33 +245,74 @@ void Screen_EPD_EXT3_Fast::COG_MediumKP_sendImageData(uint8_t updateMode)
     }
 
     // Copy next frame to previous frame
-    memcpy(previousBuffer, nextBuffer, u_pageColourSize); // Copy displayed next to previous
+    s_copyDirtyBand(); // Copy displayed next to previous, dirty band only
 }
 
-void Screen_EPD_EXT3_Fast::COG_MediumKP_update(uint8_t updateMode)
+void Screen_EPD_EXT3_Fast::COG_MediumKP_sendImageWindow(uint8_t updateMode)
 {
-    // Initial COG
-    // Application note § 3.1 Initial flow chart
-    b_sendCommandData8(0x05, 0x7d);
-    delay(50);
-    b_sendCommandData8(0x05, 0x00);
-    delay(1);
-    b_sendCommandData8(0xd8, COG_data[0x1c]); // MS_SYNC
-    b_sendCommandData8(0xd6, COG_data[0x1d]); // BVSS
+    // Same as COG_MediumKP_sendImageData() with the window of flushRegion()
+    uint32_t offset = (uint32_t)s_windowLine1 * u_bufferSizeH + s_windowByte1;
+    FRAMEBUFFER_TYPE nextBuffer = s_newImage + offset;
+    FRAMEBUFFER_TYPE previousBuffer = s_newImage + u_pageColourSize + offset;
+    uint16_t bytes = s_windowByte2 - s_windowByte1 + 1;
+    uint16_t lines = s_windowLine2 - s_windowLine1 + 1;
+
+    uint8_t workDUW[6];
+    workDUW[0] = s_windowByte1; // x start, byte
+    workDUW[1] = s_windowByte2; // x end, byte
+    workDUW[2] = s_windowLine1 >> 8; // y start, MSB
+    workDUW[3] = s_windowLine1 & 0xff; // y start, LSB
+    workDUW[4] = s_windowLine2 >> 8; // y end, MSB
+    workDUW[5] = s_windowLine2 & 0xff; // y end, LSB
+
+    uint8_t workDRFW[4];
+    workDRFW[0] = s_windowByte1; // x start, byte
+    workDRFW[1] = s_windowByte2; // x end, byte
+    workDRFW[2] = s_windowLine1 / 2; // y start, pair of lines
+    workDRFW[3] = s_windowLine2 / 2; // y end, pair of lines
+
+    uint8_t workRAM_RW[3];
+    workRAM_RW[0] = s_windowByte1; // x, byte
+    workRAM_RW[1] = s_windowLine1 >> 8; // y, MSB
+    workRAM_RW[2] = s_windowLine1 & 0xff; // y, LSB
 
-    b_sendCommandData8(0xa7, 0x10);
-    delay(2);
-    b_sendCommandData8(0xa7, 0x00);
-    delay(10);
+    // Send image data
+    b_sendIndexData(0x13, workDUW, 6); // DUW
+    b_sendIndexData(0x90, workDRFW, 4); // DRFW
 
-    b_sendCommandData8(0x44, 0x00);
-    b_sendCommandData8(0x45, 0x80);
+    // Next frame
+    b_sendIndexData(0x12, workRAM_RW, 3); // RAM_RW
+    b_sendIndexDataWindow(0x10, nextBuffer, bytes, lines, u_bufferSizeH); // Next frame
 
-    b_sendCommandData8(0xa7, 0x10);
-    delay(2);
-    b_sendCommandData8(0xa7, 0x00);
-    delay(10);
+    switch (updateMode)
+    {
+        case UPDATE_GLOBAL:
+
+            // Previous frame = dummy
+            b_sendIndexData(0x12, workRAM_RW, 3); // RAM_RW
+            b_sendIndexFixed(0x11, 0x00, (uint32_t)bytes * lines); // Previous frame = dummy
+            break;
+
+        case UPDATE_FAST:
+
+            // Previous frame
+            b_sendIndexData(0x12, workRAM_RW, 3); // RAM_RW
+            b_sendIndexDataWindow(0x11, previousBuffer, bytes, lines, u_bufferSizeH); // Previous frame
+            break;
+
+        default:
+            break;
+    }
+
+    // Copy next frame to previous frame, window only
+    for (uint16_t line = 0; line < lines; line += 1)
+    {
+        memcpy(previousBuffer + (uint32_t)line * u_bufferSizeH, nextBuffer + (uint32_t)line * u_bufferSizeH, bytes);
+    }
+}
 
+uint8_t Screen_EPD_EXT3_Fast::COG_MediumKP_getIndexTemperature(uint8_t updateMode)
+{
     uint8_t indexTemperature;
     switch (u_eScreen_EPD)
     {
@@ -313,32 +392,121 @@ void Screen_EPD_EXT3_Fast::COG_MediumKP_update(uint8_t updateMode)
             break;
     }
 
-    b_sendCommandData8(0x44, 0x06);
-    b_sendCommandData8(0x45, indexTemperature);
-
-    b_sendCommandData8(0xa7, 0x10);
-    delay(2);
-    b_sendCommandData8(0xa7, 0x00);
-    delay(10);
+    return indexTemperature;
+}
 
-    b_sendCommandData8(0x60, COG_data[0x0b]); // TCON
-    b_sendCommandData8(0x61, COG_data[0x1b]); // STV_DIR
-    // No DCTL here
-    b_sendCommandData8(0x02, COG_data[0x11]); // VCOM
-    switch (u_eScreen_EPD)
+bool Screen_EPD_EXT3_Fast::COG_MediumKP_update(uint8_t updateMode)
+{
+    switch (s_flushStep)
     {
-        case eScreen_EPD_581_KS_0B:
+        case 0:
 
-            b_sendCommandData8(0x03, COG_data[0x1f]); // VCOM_CTRL
+            // Initial COG
+            // Application note § 3.1 Initial flow chart
+            b_sendCommandData8(0x05, 0x7d);
+            s_waitFlush(50000); // 50 ms
             break;
 
-        default:
+        case 1:
+
+            b_sendCommandData8(0x05, 0x00);
+            s_waitFlush(1000); // 1 ms
+            break;
+
+        case 2:
+
+            b_sendCommandData8(0xd8, COG_data[0x1c]); // MS_SYNC
+            b_sendCommandData8(0xd6, COG_data[0x1d]); // BVSS
+
+            b_sendCommandData8(0xa7, 0x10);
+            s_waitFlush(2000); // 2 ms
+            break;
+
+        case 3:
+
+            b_sendCommandData8(0xa7, 0x00);
+            s_waitFlush(10000); // 10 ms
+            break;
+
+        case 4:
+
+            b_sendCommandData8(0x44, 0x00);
+            b_sendCommandData8(0x45, 0x80);
+
+            b_sendCommandData8(0xa7, 0x10);
+            s_waitFlush(2000); // 2 ms
+            break;
+
+        case 5:
+
+            b_sendCommandData8(0xa7, 0x00);
+            s_waitFlush(10000); // 10 ms
+            break;
+
+        case 6:
+
+            b_sendCommandData8(0x44, 0x06);
+            b_sendCommandData8(0x45, COG_MediumKP_getIndexTemperature(updateMode));
+
+            b_sendCommandData8(0xa7, 0x10);
+            s_waitFlush(2000); // 2 ms
+            break;
+
+        case 7:
+
+            b_sendCommandData8(0xa7, 0x00);
+            s_waitFlush(10000); // 10 ms
+            break;
+
+        case 8:
+
+            b_sendCommandData8(0x60, COG_data[0x0b]); // TCON
+            b_sendCommandData8(0x61, COG_data[0x1b]); // STV_DIR
+            // No DCTL here
+            b_sendCommandData8(0x02, COG_data[0x11]); // VCOM
+            switch (u_eScreen_EPD)
+            {
+                case eScreen_EPD_581_KS_0B:
+
+                    b_sendCommandData8(0x03, COG_data[0x1f]); // VCOM_CTRL
+                    break;
+
+                default:
+
+                    break;
+            }
 
+            s_flushStage = 0;
+            s_flushRepeat = 0;
+            s_flushHalf = 0;
             break;
+
+        case 9:
+
+            // DC/DC Soft-start, one step per call until done
+            // Application note § 3.3 DC/DC soft-start
+            if (COG_MediumKP_softStart() == false)
+            {
+                return false; // same step
+            }
+
+            // Display Refresh Start
+            // Application note § 4 Send updating command
+            s_waitFlushBusy();
+            break;
+
+        default:
+
+            b_sendCommandData8(0x15, 0x3c);
+            return true;
     }
 
-    // DC/DC Soft-start
-    // Application note § 3.3 DC/DC soft-start
+    s_flushStep += 1;
+    return false;
+}
+
+bool Screen_EPD_EXT3_Fast::COG_MediumKP_softStart()
+{
     // DRIVER_B = 0x28, DRIVER_8 = 0x20
     uint8_t offsetFrame = 0x28;
 
@@ -359,117 +527,119 @@ void Screen_EPD_EXT3_Fast::COG_MediumKP_update(uint8_t updateMode)
             break;
     }
 
-    for (uint8_t stage = 0; stage < 4; stage += 1)
+    while (s_flushStage < 4)
     {
-        uint8_t offset = offsetFrame + 0x08 * stage;
+        uint8_t offset = offsetFrame + 0x08 * s_flushStage;
         uint8_t FORMAT = COG_data[offset] & 0x80;
         uint8_t REPEAT = COG_data[offset] & 0x7f;
 
+        if (s_flushRepeat >= REPEAT)
+        {
+            s_flushStage += 1;
+            s_flushRepeat = 0;
+            continue;
+        }
+
         if (FORMAT > 0) // Format 1
         {
+            // PHL and PHH incremented before each repeat
             uint8_t PHL_PHH[2];
-            PHL_PHH[0] = COG_data[offset + 1]; // PHL_INI
-            PHL_PHH[1] = COG_data[offset + 2]; // PHH_INI
-            uint8_t PHL_VAR = COG_data[offset + 3];
-            uint8_t PHH_VAR = COG_data[offset + 4];
+            PHL_PHH[0] = COG_data[offset + 1] + (s_flushRepeat + 1) * COG_data[offset + 3]; // PHL_INI + PHL_VAR
+            PHL_PHH[1] = COG_data[offset + 2] + (s_flushRepeat + 1) * COG_data[offset + 4]; // PHH_INI + PHH_VAR
             uint8_t BST_SW_a = COG_data[offset + 5] & _filter09;
             uint8_t BST_SW_b = COG_data[offset + 6] & _filter09;
-            uint8_t DELAY_SCALE = COG_data[offset + 7] & 0x80;
-            uint16_t DELAY_VALUE = COG_data[offset + 7] & 0x7f;
-
-            for (uint8_t i = 0; i < REPEAT; i += 1)
-            {
-                b_sendCommandData8(0x09, BST_SW_a);
-                PHL_PHH[0] += PHL_VAR; // PHL
-                PHL_PHH[1] += PHH_VAR; // PHH
-                b_sendIndexData(0x51, PHL_PHH, 2);
-                b_sendCommandData8(0x09, BST_SW_b);
 
-                if (DELAY_SCALE > 0)
-                {
-                    delay(DELAY_VALUE); // ms
-                }
-                else
-                {
-                    delayMicroseconds(10 * DELAY_VALUE); //10 us
-                }
-            }
+            b_sendCommandData8(0x09, BST_SW_a);
+            b_sendIndexData(0x51, PHL_PHH, 2);
+            b_sendCommandData8(0x09, BST_SW_b);
+            s_waitFlush(COG_MediumKP_getDelay(COG_data[offset + 7]));
+            s_flushRepeat += 1;
         }
-        else // Format 2
+        else if (s_flushHalf == 0) // Format 2, first half
         {
             uint8_t BST_SW_a = COG_data[offset + 1] & _filter09;
-            uint8_t BST_SW_b = COG_data[offset + 2] & _filter09;
-            uint8_t DELAY_a_SCALE = COG_data[offset + 3] & 0x80;
-            uint16_t DELAY_a_VALUE = COG_data[offset + 3] & 0x7f;
-            uint8_t DELAY_b_SCALE = COG_data[offset + 4] & 0x80;
-            uint16_t DELAY_b_VALUE = COG_data[offset + 4] & 0x7f;
 
-            for (uint8_t i = 0; i < REPEAT; i += 1)
-            {
-                b_sendCommandData8(0x09, BST_SW_a);
-
-                if (DELAY_a_SCALE > 0)
-                {
-                    delay(DELAY_a_VALUE); // ms
-                }
-                else
-                {
-                    delayMicroseconds(10 * DELAY_a_VALUE); // 10 us
-                }
-
-                b_sendCommandData8(0x09, BST_SW_b);
+            b_sendCommandData8(0x09, BST_SW_a);
+            s_waitFlush(COG_MediumKP_getDelay(COG_data[offset + 3]));
+            s_flushHalf = 1;
+        }
+        else // Format 2, second half
+        {
+            uint8_t BST_SW_b = COG_data[offset + 2] & _filter09;
 
-                if (DELAY_b_SCALE > 0)
-                {
-                    delay(DELAY_b_VALUE); // ms
-                }
-                else
-                {
-                    delayMicroseconds(10 * DELAY_b_VALUE); // 10 us
-                }
-            }
+            b_sendCommandData8(0x09, BST_SW_b);
+            s_waitFlush(COG_MediumKP_getDelay(COG_data[offset + 4]));
+            s_flushHalf = 0;
+            s_flushRepeat += 1;
         }
+        return false;
     }
 
-    // Display Refresh Start
-    // Application note § 4 Send updating command
-    b_waitBusy();
-    b_sendCommandData8(0x15, 0x3c);
+    return true;
 }
 
-void Screen_EPD_EXT3_Fast::COG_MediumKP_powerOff()
+uint32_t Screen_EPD_EXT3_Fast::COG_MediumKP_getDelay(uint8_t delayOTP)
 {
-    // Application note § 5. Turn-off DC/DC
+    uint8_t DELAY_SCALE = delayOTP & 0x80;
+    uint16_t DELAY_VALUE = delayOTP & 0x7f;
 
-    // DC-DC off
-    b_waitBusy();
+    if (DELAY_SCALE > 0)
+    {
+        return 1000 * (uint32_t)DELAY_VALUE; // ms
+    }
+    else
+    {
+        return 10 * (uint32_t)DELAY_VALUE; // 10 us
+    }
+}
 
-    switch (u_eScreen_EPD)
+bool Screen_EPD_EXT3_Fast::COG_MediumKP_powerOff()
+{
+    // Application note § 5. Turn-off DC/DC
+    switch (s_flushStep)
     {
-        case eScreen_EPD_343_PS_0B:
-        case eScreen_EPD_343_PS_0B_Touch:
-        case eScreen_EPD_581_PS_0B:
+        case 0:
 
-            b_sendCommandData8(0x09, 0x7b);
-            b_sendCommandData8(0x05, 0x5d);
-            b_sendCommandData8(0x09, 0x7a);
-            delay(15);
-            b_sendCommandData8(0x09, 0x00);
+            // DC-DC off
+            s_waitFlushBusy();
             break;
 
-        case eScreen_EPD_581_KS_0B:
+        case 1:
 
-            b_sendCommandData8(0x09, 0x7f);
-            b_sendCommandData8(0x05, 0x3d);
-            b_sendCommandData8(0x09, 0x7e);
-            delay(60);
-            b_sendCommandData8(0x09, 0x00);
+            switch (u_eScreen_EPD)
+            {
+                case eScreen_EPD_343_PS_0B:
+                case eScreen_EPD_343_PS_0B_Touch:
+                case eScreen_EPD_581_PS_0B:
+
+                    b_sendCommandData8(0x09, 0x7b);
+                    b_sendCommandData8(0x05, 0x5d);
+                    b_sendCommandData8(0x09, 0x7a);
+                    s_waitFlush(15000); // 15 ms
+                    break;
+
+                case eScreen_EPD_581_KS_0B:
+
+                    b_sendCommandData8(0x09, 0x7f);
+                    b_sendCommandData8(0x05, 0x3d);
+                    b_sendCommandData8(0x09, 0x7e);
+                    s_waitFlush(60000); // 60 ms
+                    break;
+
+                default:
+
+                    return true;
+            }
             break;
 
         default:
 
-            break;
+            b_sendCommandData8(0x09, 0x00);
+            return true;
     }
+
+    s_flushStep += 1;
+    return false;
 }
 //
 // --- End of Medium screens with K or P film
@@ -801,10 +971,10 @@ void Screen_EPD_EXT3_Fast::COG_SmallKP_sendImageData(uint8_t updateMode)
     } // u_eScreen_EPD
 
     // Copy next frame to previous frame
-    memcpy(previousBuffer, nextBuffer, u_pageColourSize); // Copy displayed next to previous
+    s_copyDirtyBand(); // Copy displayed next to previous, dirty band only
 }
 
-void Screen_EPD_EXT3_Fast::COG_SmallKP_update(uint8_t updateMode)
+bool Screen_EPD_EXT3_Fast::COG_SmallKP_update(uint8_t updateMode)
 {
     // Application note § 6. Send updating command
     switch (u_eScreen_EPD)
@@ -812,26 +982,59 @@ void Screen_EPD_EXT3_Fast::COG_SmallKP_update(uint8_t updateMode)
         case eScreen_EPD_150_KS_0J:
         case eScreen_EPD_152_KS_0J:
 
-            b_waitBusy(LOW); // 152 specific
-            b_sendCommand8(0x20); // Display Refresh
-            digitalWrite(b_pin.panelCS, HIGH); // CS# = 1
-            b_waitBusy(LOW); // 152 specific
+            switch (s_flushStep)
+            {
+                case 0:
+
+                    s_waitFlushBusy(LOW); // 152 specific
+                    break;
+
+                case 1:
+
+                    b_sendCommand8(0x20); // Display Refresh
+                    digitalWrite(b_pin.panelCS, HIGH); // CS# = 1
+                    s_waitFlushBusy(LOW); // 152 specific
+                    break;
+
+                default:
+
+                    return true;
+            }
             break;
 
         default:
 
-            b_waitBusy();
+            switch (s_flushStep)
+            {
+                case 0:
 
-            b_sendCommand8(0x04); // Power on
-            b_waitBusy();
+                    s_waitFlushBusy();
+                    break;
 
-            b_sendCommand8(0x12); // Display Refresh
-            b_waitBusy();
+                case 1:
+
+                    b_sendCommand8(0x04); // Power on
+                    s_waitFlushBusy();
+                    break;
+
+                case 2:
+
+                    b_sendCommand8(0x12); // Display Refresh
+                    s_waitFlushBusy();
+                    break;
+
+                default:
+
+                    return true;
+            }
             break;
     }
+
+    s_flushStep += 1;
+    return false;
 }
 
-void Screen_EPD_EXT3_Fast::COG_SmallKP_powerOff()
+bool Screen_EPD_EXT3_Fast::COG_SmallKP_powerOff()
 {
     // Application note § 7. Turn-off DC/DC
     switch (u_eScreen_EPD)
@@ -839,14 +1042,22 @@ void Screen_EPD_EXT3_Fast::COG_SmallKP_powerOff()
         case eScreen_EPD_150_KS_0J:
         case eScreen_EPD_152_KS_0J:
 
-            break;
+            return true;
 
         default:
 
+            if (s_flushStep > 0)
+            {
+                return true;
+            }
+
             b_sendCommand8(0x02); // Turn off DC/DC
-            b_waitBusy();
+            s_waitFlushBusy();
             break;
     }
+
+    s_flushStep += 1;
+    return false;
 }
 //
 // --- End of Small screens with K or P film
@@ -865,10 +1076,34 @@ Screen_EPD_EXT3_Fast::Screen_EPD_EXT3_Fast(eScreen_EPD_t eScreen_EPD_EXT3, pins_
     b_pin = board;
     s_newImage = 0; // nullptr
     COG_data[0] = 0;
+    s_flagProfile = false;
+    s_orientSizeX = 0; // no point before begin()
+    s_orientSizeY = 0;
+    s_setClean();
+    s_flagDisplayed = false;
+    s_windowLine1 = 0xffff; // full screen
+    s_windowLine2 = 0;
+    s_windowByte1 = 0;
+    s_windowByte2 = 0;
+    s_flushPhase = PHASE_FLUSH; // no update in progress
+    s_flushBusy = FLUSH_BUSY_NONE;
+    s_flushDelay = 0;
+    s_flushCallback = 0; // nullptr
+#if (GLYPH_CACHE_SIZE > 0)
+    s_glyphCache = 0; // nullptr, allocated on first use
+    s_glyphFont = 0xff; // none
+    s_glyphOrientation = 0xff;
+#endif // GLYPH_CACHE_SIZE
 }
 
 void Screen_EPD_EXT3_Fast::begin()
 {
+    // Profile
+    uint32_t chrono = micros();
+    uint32_t chronoBegin = chrono;
+    memset(s_profileBegin, 0x00, sizeof(s_profileBegin));
+    s_flagProfile = true;
+
     // u_eScreen_EPD = eScreen_EPD_EXT3;
     u_codeSize = SCREEN_SIZE(u_eScreen_EPD);
     u_codeFilm = SCREEN_FILM(u_eScreen_EPD);
@@ -978,12 +1213,14 @@ void Screen_EPD_EXT3_Fast::begin()
             break;
     } // u_codeSize
     v_screenDiagonal = u_codeSize;
+    s_recordStage(STAGE_CONFIGURATION, chrono);
 
     // Report
     mySerial.println(formatString("hV = Screen %s %ix%i", WhoAmI().c_str(), screenSizeX(), screenSizeY()));
     mySerial.println(formatString("hV = Number %i-%cS-0%c", u_codeSize, u_codeFilm, u_codeDriver));
     mySerial.println(formatString("hV = PDLS %s v%i.%i.%i", SCREEN_EPD_EXT3_VARIANT, SCREEN_EPD_EXT3_RELEASE / 100, (SCREEN_EPD_EXT3_RELEASE / 10) % 10, SCREEN_EPD_EXT3_RELEASE % 10));
     mySerial.println();
+    s_recordStage(STAGE_REPORT, chrono);
 
     u_bufferDepth = v_screenColourBits; // 2 colours
     u_bufferSizeV = v_screenSizeV; // vertical = wide size
@@ -1014,14 +1251,25 @@ void Screen_EPD_EXT3_Fast::begin()
 #endif // ESP32 BOARD_HAS_PSRAM
 
     memset(s_newImage, 0x00, u_pageColourSize * u_bufferDepth);
+    s_setClean(); // previous = next
+    s_flagDisplayed = false; // panel content unknown
+    s_recordStage(STAGE_FRAME_BUFFER, chrono);
 
     setTemperatureC(25); // 25 Celsius = 77 Fahrenheit
     b_fsmPowerScreen = FSM_OFF;
     setPowerProfile(POWER_MODE_MANUAL, POWER_SCOPE_GPIO_ONLY);
 
+#if defined(hV_HAL_HOST)
+
+    // Emulated panel, unless already attached
+    hV_HAL_Host_beginPanel(u_eScreen_EPD, b_pin);
+
+#endif // hV_HAL_HOST
+
     // Turn SPI on, initialise GPIOs and set GPIO levels
     // Reset panel and get tables
-    resume();
+    resume(); // Stages STAGE_RESET, STAGE_OTP and STAGE_SPI
+    chrono = micros();
 
     // Fonts
     hV_Screen_Buffer::begin(); // Standard
@@ -1037,6 +1285,9 @@ void Screen_EPD_EXT3_Fast::begin()
 
     v_penSolid = false;
     u_invert = false;
+    s_recordStage(STAGE_FONTS, chrono);
+    s_countSetPoint = 0;
+    resetFlushStatistics();
 
     //
     // === Touch section
@@ -1052,6 +1303,10 @@ void Screen_EPD_EXT3_Fast::begin()
     //
     // === End of Touch section
     //
+    s_recordStage(STAGE_TOUCH, chrono);
+
+    s_recordStage(STAGE_BEGIN, chronoBegin);
+    s_flagProfile = false;
 }
 
 STRING_TYPE Screen_EPD_EXT3_Fast::WhoAmI()
@@ -1080,6 +1335,8 @@ void Screen_EPD_EXT3_Fast::resume()
     //          FSM_SLEEP
     if (b_fsmPowerScreen != FSM_ON)
     {
+        uint32_t chrono = micros();
+
         if ((b_fsmPowerScreen & FSM_GPIO_MASK) != FSM_GPIO_MASK)
         {
             b_resume(); // GPIO
@@ -1088,6 +1345,7 @@ void Screen_EPD_EXT3_Fast::resume()
 
             b_fsmPowerScreen |= FSM_GPIO_MASK;
         }
+        s_recordStage(STAGE_RESET, chrono);
 
         // Check type and get tables
         if (u_flagOTP == false)
@@ -1096,6 +1354,7 @@ void Screen_EPD_EXT3_Fast::resume()
 
             s_reset(); // Reset
         }
+        s_recordStage(STAGE_OTP, chrono);
 
         // Start SPI
         switch (u_eScreen_EPD)
@@ -1117,6 +1376,7 @@ void Screen_EPD_EXT3_Fast::resume()
                 hV_HAL_SPI_begin(); // Standard 8 MHz, with unicity check
                 break;
         }
+        s_recordStage(STAGE_SPI, chrono);
     }
 }
 
@@ -1167,28 +1427,45 @@ void Screen_EPD_EXT3_Fast::s_getDataOTP()
 
 void Screen_EPD_EXT3_Fast::s_flush(uint8_t updateMode)
 {
+    // Asynchronous update in progress
+    s_flushComplete();
+
+    s_flushBegin(updateMode);
+    s_flushComplete();
+}
+
+void Screen_EPD_EXT3_Fast::s_flushBegin(uint8_t updateMode)
+{
+    // Statistics
+    s_flushChrono = micros();
+    s_flushChronoFlush = s_flushChrono;
+    b_timeBusy = 0;
+    resetBoardCounters();
+    hV_HAL_TRACE(TRACE_FLUSH_BEGIN, updateMode);
+
     // Resume
     if (b_fsmPowerScreen != FSM_ON)
     {
         resume();
     }
+    s_recordPhase(PHASE_RESUME, s_flushChrono);
 
     switch (b_family)
     {
         case FAMILY_MEDIUM:
 
             COG_MediumKP_initial(updateMode); // Initialise
+            s_recordPhase(PHASE_INITIAL, s_flushChrono);
             COG_MediumKP_sendImageData(updateMode); // Send image data
-            COG_MediumKP_update(updateMode); // Update
-            COG_MediumKP_powerOff(); // Power off
+            s_recordPhase(PHASE_SEND_IMAGE, s_flushChrono);
             break;
 
         case FAMILY_SMALL:
 
             COG_SmallKP_initial(updateMode); // Initialise
+            s_recordPhase(PHASE_INITIAL, s_flushChrono);
             COG_SmallKP_sendImageData(updateMode); // Send image data
-            COG_SmallKP_update(updateMode); // Update
-            COG_SmallKP_powerOff(); // Power off
+            s_recordPhase(PHASE_SEND_IMAGE, s_flushChrono);
             break;
 
         default:
@@ -1196,195 +1473,1739 @@ void Screen_EPD_EXT3_Fast::s_flush(uint8_t updateMode)
             break;
     }
 
-    // Suspend
-    if (u_suspendMode == POWER_MODE_AUTO)
-    {
-        suspend(u_suspendScope);
-    }
+    // Update and power off, with s_flushNext()
+    s_flushMode = updateMode;
+    s_flushPhase = PHASE_UPDATE;
+    s_flushStep = 0;
+    s_flushDelay = 0;
+    s_flushBusy = FLUSH_BUSY_NONE;
+    s_flushCallback = 0; // nullptr
 }
 
-uint8_t Screen_EPD_EXT3_Fast::flushMode(uint8_t updateMode)
+void Screen_EPD_EXT3_Fast::s_flushNext()
 {
-    updateMode = checkTemperatureMode(updateMode);
+    bool flagDone = true;
 
-    switch (updateMode)
+    switch (b_family)
     {
-        case UPDATE_FAST:
-        case UPDATE_GLOBAL:
+        case FAMILY_MEDIUM:
 
-            s_flush(UPDATE_FAST);
+            if (s_flushPhase == PHASE_UPDATE)
+            {
+                flagDone = COG_MediumKP_update(s_flushMode); // Update
+            }
+            else
+            {
+                flagDone = COG_MediumKP_powerOff(); // Power off
+            }
             break;
 
-        default:
+        case FAMILY_SMALL:
 
-            mySerial.println();
-            mySerial.println("hV ! PDLS - UPDATE_NONE invoked");
+            if (s_flushPhase == PHASE_UPDATE)
+            {
+                flagDone = COG_SmallKP_update(s_flushMode); // Update
+            }
+            else
+            {
+                flagDone = COG_SmallKP_powerOff(); // Power off
+            }
             break;
+
+        default:
+
+            s_flushEnd();
+            return;
     }
 
-    return updateMode;
+    if (flagDone)
+    {
+        s_flushStep = 0;
+        s_recordPhase(s_flushPhase, s_flushChrono);
+
+        if (s_flushPhase == PHASE_UPDATE)
+        {
+            s_flushPhase = PHASE_POWER_OFF;
+        }
+        else
+        {
+            s_flushEnd();
+        }
+    }
 }
 
-void Screen_EPD_EXT3_Fast::flush()
+void Screen_EPD_EXT3_Fast::s_flushEnd()
 {
-    flushMode(UPDATE_FAST);
+    updateStatistics(s_statisticsFlush[PHASE_WAIT_BUSY], b_timeBusy);
+    hV_HAL_TRACE(TRACE_FLUSH_END, micros() - s_flushChronoFlush);
+    s_recordPhase(PHASE_FLUSH, s_flushChronoFlush);
+
+    // Suspend
+    if (u_suspendMode == POWER_MODE_AUTO)
+    {
+        suspend(u_suspendScope);
+    }
+
+    s_flushPhase = PHASE_FLUSH; // done
+
+    if (s_flushCallback != 0)
+    {
+        s_flushCallback();
+    }
 }
 
-void Screen_EPD_EXT3_Fast::clear(uint16_t colour)
+void Screen_EPD_EXT3_Fast::s_flushComplete()
 {
-    if (colour == myColours.grey)
+    while (s_flushPhase != PHASE_FLUSH)
     {
-        // black = 0-1, white = 0-0
-        for (uint16_t i = 0; i < u_bufferSizeV; i++)
+        // Blocking wait
+        if (s_flushBusy != FLUSH_BUSY_NONE)
         {
-            uint8_t pattern = (i % 2) ? 0b10101010 : 0b01010101;
-            for (uint16_t j = 0; j < u_bufferSizeH; j++)
+            b_waitBusy(s_flushBusy);
+            s_flushBusy = FLUSH_BUSY_NONE;
+        }
+        else if (s_flushDelay > 0)
+        {
+            if (s_flushDelay % 1000 == 0)
             {
-                s_newImage[i * u_bufferSizeH + j] = pattern;
+                delay(s_flushDelay / 1000); // ms
+            }
+            else
+            {
+                delayMicroseconds(s_flushDelay); // us
             }
+            s_flushDelay = 0;
         }
+
+        s_flushNext();
     }
-    else if ((colour == myColours.white) xor u_invert)
-    {
-        // physical black 0-0
-        memset(s_newImage, 0x00, u_pageColourSize);
-    }
-    else
+}
+
+bool Screen_EPD_EXT3_Fast::poll()
+{
+    while (s_flushPhase != PHASE_FLUSH)
+    {
+        // Non-blocking wait
+        if (s_flushBusy != FLUSH_BUSY_NONE)
+        {
+            if (digitalRead(b_pin.panelBusy) != s_flushBusy)
+            {
+                return false;
+            }
+
+            uint32_t chrono = micros() - s_flushChronoWait;
+            b_timeBusy += chrono;
+            hV_HAL_TRACE(TRACE_WAIT_BUSY, chrono);
+            s_flushBusy = FLUSH_BUSY_NONE;
+        }
+        else if (s_flushDelay > 0)
+        {
+            if (micros() - s_flushChronoWait < s_flushDelay)
+            {
+                return false;
+            }
+            s_flushDelay = 0;
+        }
+
+        s_flushNext();
+    }
+
+    return true;
+}
+
+void Screen_EPD_EXT3_Fast::s_waitFlush(uint32_t us)
+{
+    s_flushDelay = us;
+    s_flushChronoWait = micros();
+}
+
+void Screen_EPD_EXT3_Fast::s_waitFlushBusy(uint8_t level)
+{
+    s_flushBusy = level;
+    s_flushChronoWait = micros();
+}
+
+bool Screen_EPD_EXT3_Fast::isFlushDone()
+{
+    return (s_flushPhase == PHASE_FLUSH);
+}
+
+uint8_t Screen_EPD_EXT3_Fast::getFlushPhase()
+{
+    return s_flushPhase;
+}
+
+uint8_t Screen_EPD_EXT3_Fast::flushMode(uint8_t updateMode)
+{
+    if (s_isUnchanged())
+    {
+        return UPDATE_UNCHANGED;
+    }
+
+    updateMode = checkTemperatureMode(updateMode);
+
+    switch (updateMode)
+    {
+        case UPDATE_FAST:
+        case UPDATE_GLOBAL:
+
+            s_flush(UPDATE_FAST);
+            break;
+
+        default:
+
+            mySerial.println();
+            mySerial.println("hV ! PDLS - UPDATE_NONE invoked");
+            break;
+    }
+
+    return updateMode;
+}
+
+void Screen_EPD_EXT3_Fast::flush()
+{
+    flushMode(UPDATE_FAST);
+}
+
+uint8_t Screen_EPD_EXT3_Fast::flushAsync(uint8_t updateMode, void (*callback)())
+{
+    if (isFlushDone() == false)
+    {
+        return UPDATE_NONE; // update in progress
+    }
+
+    if (s_isUnchanged())
+    {
+        return UPDATE_UNCHANGED;
+    }
+
+    updateMode = checkTemperatureMode(updateMode);
+
+    switch (updateMode)
+    {
+        case UPDATE_FAST:
+        case UPDATE_GLOBAL:
+
+            s_flushBegin(UPDATE_FAST);
+            s_flushCallback = callback;
+            poll();
+            break;
+
+        default:
+
+            mySerial.println();
+            mySerial.println("hV ! PDLS - UPDATE_NONE invoked");
+            break;
+    }
+
+    return updateMode;
+}
+
+uint8_t Screen_EPD_EXT3_Fast::flushRegion(uint16_t x0, uint16_t y0, uint16_t dx, uint16_t dy)
+{
+    // Region within the screen, logical coordinates
+    if ((dx == 0) or (dy == 0) or (x0 >= s_orientSizeX) or (y0 >= s_orientSizeY))
+    {
+        return UPDATE_NONE;
+    }
+
+    if (s_isUnchanged())
+    {
+        return UPDATE_UNCHANGED;
+    }
+
+    // Fast update of the window, only if previous frame-buffer = panel content
+    if ((b_family != FAMILY_MEDIUM) or (s_flagDisplayed == false) or (checkTemperatureMode(UPDATE_FAST) != UPDATE_FAST))
+    {
+        return flushMode(UPDATE_FAST);
+    }
+
+    // Window, physical coordinates
+    int32_t lineX1, pointY1, lineX2, pointY2;
+    s_getPhysical(x0, y0, lineX1, pointY1);
+    s_getPhysical(hV_HAL_min((uint32_t)x0 + dx, (uint32_t)s_orientSizeX) - 1, hV_HAL_min((uint32_t)y0 + dy, (uint32_t)s_orientSizeY) - 1, lineX2, pointY2);
+
+    // Pairs of lines for DRFW, bytes for DUW
+    s_windowLine1 = hV_HAL_min(lineX1, lineX2) & 0xfffe;
+    s_windowLine2 = hV_HAL_min(hV_HAL_max(lineX1, lineX2) | 0x0001, (int32_t)v_screenSizeV - 1);
+    s_windowByte1 = hV_HAL_min(pointY1, pointY2) >> 3;
+    s_windowByte2 = hV_HAL_max(pointY1, pointY2) >> 3;
+
+    s_flush(UPDATE_FAST);
+
+    s_windowLine1 = 0xffff; // full screen
+    s_windowLine2 = 0;
+
+    return UPDATE_FAST;
+}
+
+void Screen_EPD_EXT3_Fast::clear(uint16_t colour)
+{
+    s_markDirty(0, v_screenSizeV - 1, 0, v_screenSizeH - 1);
+
+    if (colour == myColours.grey)
+    {
+        // black = 0-1, white = 0-0
+        for (uint16_t i = 0; i < u_bufferSizeV; i++)
+        {
+            uint8_t pattern = (i % 2) ? 0b10101010 : 0b01010101;
+            for (uint16_t j = 0; j < u_bufferSizeH; j++)
+            {
+                s_newImage[i * u_bufferSizeH + j] = pattern;
+            }
+        }
+    }
+    else if ((colour == myColours.white) xor u_invert)
+    {
+        // physical black 0-0
+        memset(s_newImage, 0x00, u_pageColourSize);
+    }
+    else
     {
         // physical white 1-0
         memset(s_newImage, 0xff, u_pageColourSize);
     }
 }
 
-void Screen_EPD_EXT3_Fast::regenerate(uint8_t mode)
+void Screen_EPD_EXT3_Fast::regenerate(uint8_t mode)
+{
+    clear(myColours.black);
+    s_flagDisplayed = false; // forced
+    flush();
+    delay(100);
+
+    clear(myColours.white);
+    s_flagDisplayed = false; // forced
+    flush();
+    delay(100);
+}
+
+void Screen_EPD_EXT3_Fast::s_setPoint(uint16_t x1, uint16_t y1, uint16_t colour)
+{
+    s_countSetPoint += 1;
+    hV_HAL_TRACE(TRACE_SET_POINT, ((uint32_t)x1 << 16) | y1);
+
+    // Check coordinates are within clip rectangle, logical coordinates
+    if ((x1 < v_clipX1) or (x1 >= v_clipX2) or (y1 < v_clipY1) or (y1 >= v_clipY2))
+    {
+        return;
+    }
+
+    // Convert combined colours into basic colours
+    // Grey is black for even physical x + y
+    if (colour == myColours.grey)
+    {
+        if ((x1 + y1 + s_orientParity) % 2 == 0)
+        {
+            colour = myColours.black; // black
+        }
+        else
+        {
+            colour = myColours.white; // white
+        }
+    }
+
+    // Coordinates, with oriented writer
+    uint32_t index = s_getIndex(x1, y1);
+    uint32_t z1 = index >> 3;
+    uint16_t b1 = 7 - (index & 0x07);
+    s_markPoint(x1, y1);
+
+    // Basic colours
+    if ((colour == myColours.white) xor u_invert)
+    {
+        // physical black 0-0
+        bitClear(s_newImage[z1], b1);
+    }
+    else if ((colour == myColours.black) xor u_invert)
+    {
+        // physical white 1-0
+        bitSet(s_newImage[z1], b1);
+    }
+}
+
+void Screen_EPD_EXT3_Fast::s_fillRectangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t colour)
+{
+    // Clip to clip rectangle, logical coordinates
+    if (s_isClipped(x1, y1, x2, y2))
+    {
+        return;
+    }
+    x1 = hV_HAL_max(x1, v_clipX1);
+    y1 = hV_HAL_max(y1, v_clipY1);
+    x2 = hV_HAL_min(x2, (uint16_t)(v_clipX2 - 1));
+    y2 = hV_HAL_min(y2, (uint16_t)(v_clipY2 - 1));
+
+    // Orient corners, physical coordinates
+    if (s_orientCoordinates(x1, y1) or s_orientCoordinates(x2, y2))
+    {
+        return;
+    }
+    if (x1 > x2)
+    {
+        hV_HAL_swap(x1, x2);
+    }
+    if (y1 > y2)
+    {
+        hV_HAL_swap(y1, y2);
+    }
+
+    s_fillPhysical(x1, y1, x2, y2, colour);
+}
+
+void Screen_EPD_EXT3_Fast::s_getColourMasks(uint16_t colour, uint8_t maskSet[2], uint8_t maskClear[2])
+{
+    // Convert combined colours into basic colours, same as s_setPoint()
+    // Grey is black for even x + y, bits 7, 5, 3, 1 on even lines
+    uint16_t colours[2] = { colour, colour };
+    uint8_t patterns[2][2] = { { 0xff, 0x00 }, { 0xff, 0x00 } };
+    if (colour == myColours.grey)
+    {
+        colours[0] = myColours.black;
+        colours[1] = myColours.white;
+        patterns[0][0] = 0b10101010;
+        patterns[0][1] = 0b01010101;
+        patterns[1][0] = 0b01010101;
+        patterns[1][1] = 0b10101010;
+    }
+
+    // Masks for even and odd lines
+    for (uint8_t parity = 0; parity < 2; parity += 1)
+    {
+        maskSet[parity] = 0x00;
+        maskClear[parity] = 0x00;
+        for (uint8_t index = 0; index < 2; index += 1)
+        {
+            if ((colours[index] == myColours.white) xor u_invert)
+            {
+                maskClear[parity] |= patterns[parity][index]; // physical black 0-0
+            }
+            else if ((colours[index] == myColours.black) xor u_invert)
+            {
+                maskSet[parity] |= patterns[parity][index]; // physical white 1-0
+            }
+        }
+    }
+}
+
+void Screen_EPD_EXT3_Fast::s_fillPhysical(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t colour)
+{
+    // Masks for even and odd lines
+    uint8_t maskSet[2];
+    uint8_t maskClear[2];
+    s_getColourMasks(colour, maskSet, maskClear);
+
+    // Bytes and edge masks along H
+    uint16_t byte1 = y1 >> 3;
+    uint16_t byte2 = y2 >> 3;
+    uint8_t edge1 = 0xff >> (y1 & 0x07);
+    uint8_t edge2 = 0xff << (7 - (y2 & 0x07));
+    if (byte1 == byte2)
+    {
+        edge1 &= edge2;
+    }
+
+    uint8_t * line = s_newImage + (uint32_t)x1 * u_bufferSizeH;
+    s_markDirty(x1, x2, y1, y2);
+
+    // Column of one byte per line, constant stride
+    if (byte1 == byte2)
+    {
+        uint8_t * work = line + byte1;
+        for (uint16_t x = x1; x <= x2; x += 1)
+        {
+            *work = (*work & ~(edge1 & maskClear[x % 2])) | (edge1 & maskSet[x % 2]);
+            work += u_bufferSizeH;
+        }
+        return;
+    }
+
+    // Run of bytes per line
+    for (uint16_t x = x1; x <= x2; x += 1, line += u_bufferSizeH)
+    {
+        uint8_t set = maskSet[x % 2];
+        uint8_t clear = maskClear[x % 2];
+
+        line[byte1] = (line[byte1] & ~(edge1 & clear)) | (edge1 & set);
+        if ((set | clear) == 0xff)
+        {
+            memset(line + byte1 + 1, set, byte2 - byte1 - 1);
+        }
+        else
+        {
+            for (uint16_t index = byte1 + 1; index < byte2; index += 1)
+            {
+                line[index] = (line[index] & ~clear) | set;
+            }
+        }
+        line[byte2] = (line[byte2] & ~(edge2 & clear)) | (edge2 & set);
+    }
+}
+
+void Screen_EPD_EXT3_Fast::s_getCharacterLines(uint8_t character, uint32_t lines[24])
+{
+#if (FONT_MODE == USE_FONT_TERMINAL)
+
+    uint8_t sizeX = f_font.maxWidth;
+    uint8_t sizeY = f_font.height;
+    uint8_t bytesY = (sizeY + 7) / 8; // bytes per column
+
+    // Columns of the character, bit j = row j
+    uint32_t columns[16];
+    for (uint8_t i = 0; i < sizeX; i += 1)
+    {
+        columns[i] = 0;
+        for (uint8_t b = 0; b < bytesY; b += 1)
+        {
+            columns[i] |= (uint32_t)f_getCharacter(character, bytesY * i + b) << (8 * b);
+        }
+    }
+
+    switch (v_orientation)
+    {
+        case 3: // column = line, row j = point + j, bits reversed
+
+            for (uint8_t i = 0; i < sizeX; i += 1)
+            {
+                uint32_t work = columns[i];
+                work = ((work >> 1) & 0x55555555) | ((work & 0x55555555) << 1);
+                work = ((work >> 2) & 0x33333333) | ((work & 0x33333333) << 2);
+                work = ((work >> 4) & 0x0f0f0f0f) | ((work & 0x0f0f0f0f) << 4);
+                work = ((work >> 8) & 0x00ff00ff) | ((work & 0x00ff00ff) << 8);
+                lines[i] = (work >> 16) | (work << 16);
+            }
+            break;
+
+        case 1: // column = line, row j = point - j, bits in order
+
+            for (uint8_t i = 0; i < sizeX; i += 1)
+            {
+                lines[i] = columns[i] << (32 - sizeY);
+            }
+            break;
+
+        default: // row = line, column i = point + i for 0, point - i for 2
+
+            for (uint8_t j = 0; j < sizeY; j += 1)
+            {
+                lines[j] = 0;
+            }
+            for (uint8_t i = 0; i < sizeX; i += 1)
+            {
+                uint32_t bit = (v_orientation == 2) ? ((uint32_t)1 << (32 - sizeX + i)) : ((uint32_t)0x80000000 >> i);
+                uint32_t work = columns[i];
+                for (uint8_t j = 0; work > 0; j += 1, work >>= 1)
+                {
+                    if (work & 0x01)
+                    {
+                        lines[j] |= bit;
+                    }
+                }
+            }
+            break;
+    }
+
+#endif // FONT_MODE
+}
+
+#if (GLYPH_CACHE_SIZE > 0)
+
+void Screen_EPD_EXT3_Fast::s_getCachedLines(uint8_t character, uint8_t number, uint8_t length, uint32_t lines[24])
+{
+#if (FONT_MODE == USE_FONT_TERMINAL)
+
+    uint8_t bytesLine = (length + 7) / 8;
+
+    // Cache for another font or orientation, dropped
+    if ((s_glyphFont != f_fontSize) or (s_glyphOrientation != v_orientation))
+    {
+        if (s_glyphCache == 0)
+        {
+            s_glyphCache = (uint8_t *)malloc(GLYPH_CACHE_SIZE);
+        }
+        memset(s_glyphFlags, 0x00, sizeof(s_glyphFlags));
+        s_glyphFont = f_fontSize;
+        s_glyphOrientation = v_orientation;
+        s_glyphBytes = number * bytesLine;
+        s_glyphNumber = hV_HAL_min((uint16_t)f_font.number, (uint16_t)(GLYPH_CACHE_SIZE / s_glyphBytes));
+    }
+
+    // Character not held by the cache, or no memory
+    if ((s_glyphCache == 0) or (character >= s_glyphNumber))
+    {
+        s_getCharacterLines(character, lines);
+        return;
+    }
+
+    uint8_t * work = s_glyphCache + (uint32_t)character * s_glyphBytes;
+    if (bitRead(s_glyphFlags[character >> 3], character & 0x07) == 0)
+    {
+        // First use, build and store
+        s_getCharacterLines(character, lines);
+        for (uint8_t n = 0; n < number; n += 1)
+        {
+            for (uint8_t b = 0; b < bytesLine; b += 1)
+            {
+                *work++ = lines[n] >> (24 - 8 * b);
+            }
+        }
+        bitSet(s_glyphFlags[character >> 3], character & 0x07);
+    }
+    else
+    {
+        // Next uses, bytes in physical order
+        for (uint8_t n = 0; n < number; n += 1)
+        {
+            lines[n] = 0;
+            for (uint8_t b = 0; b < bytesLine; b += 1)
+            {
+                lines[n] |= (uint32_t)(*work++) << (24 - 8 * b);
+            }
+        }
+    }
+
+#endif // FONT_MODE
+}
+
+#endif // GLYPH_CACHE_SIZE
+
+// Bit expansion for scaled characters, first point = MSB
+// Each bit of a nibble doubled, into 8 bits
+const uint8_t expandDouble[16] =
+{
+    0x00, 0x03, 0x0c, 0x0f, 0x30, 0x33, 0x3c, 0x3f, 0xc0, 0xc3, 0xcc, 0xcf, 0xf0, 0xf3, 0xfc, 0xff
+};
+
+// Each bit of a nibble tripled, into 12 bits
+const uint16_t expandTriple[16] =
+{
+    0x000, 0x007, 0x038, 0x03f, 0x1c0, 0x1c7, 0x1f8, 0x1ff, 0xe00, 0xe07, 0xe38, 0xe3f, 0xfc0, 0xfc7, 0xff8, 0xfff
+};
+
+uint8_t Screen_EPD_EXT3_Fast::s_scaleLine(uint32_t line, uint8_t length, uint8_t scale, uint8_t * data)
+{
+    uint8_t count = (length + 7) / 8;
+
+    // Scale 5 and 7, point per point
+    if ((scale == 5) or (scale == 7))
+    {
+        memset(data, 0x00, count * scale);
+        for (uint16_t index = 0; index < length; index += 1)
+        {
+            if (line & ((uint32_t)0x80000000 >> index))
+            {
+                for (uint16_t point = index * scale; point < (index + 1) * scale; point += 1)
+                {
+                    data[point >> 3] |= 0x80 >> (point & 0x07);
+                }
+            }
+        }
+        return count * scale;
+    }
+
+    for (uint8_t index = 0; index < count; index += 1)
+    {
+        data[index] = line >> (24 - 8 * index);
+    }
+
+    // Scale 2, 4, 8, doubling in place from the last byte
+    while (scale % 2 == 0)
+    {
+        for (int8_t index = count - 1; index >= 0; index -= 1)
+        {
+            uint8_t work = data[index];
+            data[2 * index] = expandDouble[work >> 4];
+            data[2 * index + 1] = expandDouble[work & 0x0f];
+        }
+        count *= 2;
+        scale /= 2;
+    }
+
+    // Scale 3 and 6, tripling in place from the last byte
+    if (scale == 3)
+    {
+        for (int8_t index = count - 1; index >= 0; index -= 1)
+        {
+            uint32_t work = ((uint32_t)expandTriple[data[index] >> 4] << 12) | expandTriple[data[index] & 0x0f];
+            data[3 * index] = work >> 16;
+            data[3 * index + 1] = work >> 8;
+            data[3 * index + 2] = work;
+        }
+        count *= 3;
+    }
+
+    return count;
+}
+
+void Screen_EPD_EXT3_Fast::s_drawCharacter(uint16_t x0, uint16_t y0, uint8_t character, uint16_t textColour, uint16_t backColour)
+{
+    s_drawCharacterScaled(x0, y0, character, 1, textColour, backColour);
+}
+
+void Screen_EPD_EXT3_Fast::s_drawCharacterScaled(uint16_t x0, uint16_t y0, uint8_t character, uint8_t scale, uint16_t textColour, uint16_t backColour)
+{
+#if (FONT_MODE == USE_FONT_TERMINAL)
+
+    uint8_t sizeX = f_font.maxWidth;
+    uint8_t sizeY = f_font.height;
+
+    // Character box, coordinates beyond 0x7fff are negative, as wrapped by uint16_t arithmetic
+    int32_t boxX1 = (int16_t)x0;
+    int32_t boxY1 = (int16_t)y0;
+    int32_t boxX2 = boxX1 + sizeX * scale - 1;
+    int32_t boxY2 = boxY1 + sizeY * scale - 1;
+
+    if (s_isClipped(boxX1, boxY1, boxX2, boxY2))
+    {
+        return;
+    }
+
+    // Character partly outside the clip rectangle
+    bool flagPartial = (boxX1 < v_clipX1) or (boxY1 < v_clipY1) or (boxX2 >= v_clipX2) or (boxY2 >= v_clipY2);
+
+    // Physical coordinates of the top left point
+    int32_t lineX; // first line, along V
+    int32_t pointY; // first point, along H
+    s_getPhysical(boxX1, boxY1, lineX, pointY);
+
+    // Physical lines, bit 31 = first point of the line along H
+    uint8_t number; // number of lines
+    uint8_t length; // points per line
+    int8_t stepX; // next line, along V
+
+    switch (v_orientation)
+    {
+        case 3: // column = line, row j = point + j
+
+            number = sizeX;
+            length = sizeY;
+            stepX = -1;
+            break;
+
+        case 2: // row = line, column i = point - i
+
+            number = sizeY;
+            length = sizeX;
+            stepX = -1;
+            pointY -= sizeX * scale - 1;
+            break;
+
+        case 1: // column = line, row j = point - j
+
+            number = sizeX;
+            length = sizeY;
+            stepX = 1;
+            pointY -= sizeY * scale - 1;
+            break;
+
+        default: // row = line, column i = point + i
+
+            number = sizeY;
+            length = sizeX;
+            stepX = 1;
+            break;
+    }
+
+    uint32_t lines[24];
+
+#if (GLYPH_CACHE_SIZE > 0)
+
+    // Orientation 1 matches the columns of the font, others are rotated
+    if (v_orientation != 1)
+    {
+        s_getCachedLines(character, number, length, lines);
+    }
+    else
+    {
+        s_getCharacterLines(character, lines);
+    }
+
+#else
+
+    s_getCharacterLines(character, lines);
+
+#endif // GLYPH_CACHE_SIZE
+
+    // Masks for text and background, even and odd lines
+    uint8_t textSet[2], textClear[2];
+    uint8_t backSet[2] = { 0x00, 0x00 };
+    uint8_t backClear[2] = { 0x00, 0x00 };
+    s_getColourMasks(textColour, textSet, textClear);
+    if (f_fontSolid)
+    {
+        s_getColourMasks(backColour, backSet, backClear);
+    }
+
+    if (flagPartial)
+    {
+        s_drawLinesClipped(lines, number, length, scale, lineX, stepX, pointY, textSet, textClear, backSet, backClear);
+        return;
+    }
+
+    uint8_t shift = pointY & 0x07;
+    uint8_t * line = s_newImage + lineX * u_bufferSizeH + (pointY >> 3);
+    int32_t stepLine = (int32_t)stepX * u_bufferSizeH;
+
+    int32_t lastX = lineX + stepX * (number * scale - 1);
+    s_markDirty(hV_HAL_min(lineX, lastX), hV_HAL_max(lineX, lastX), pointY, pointY + length * scale - 1);
+
+    if (scale == 1)
+    {
+        // Each line covers up to 4 bytes, whole bytes when aligned, shifted masks otherwise
+        uint8_t bytes = (shift + length + 7) / 8;
+        uint32_t mask = ((uint32_t)0xffffffff << (32 - length)) >> shift;
+
+        for (uint8_t n = 0; n < number; n += 1, lineX += stepX, line += stepLine)
+        {
+            uint8_t parity = lineX % 2;
+            uint32_t text = lines[n] >> shift;
+
+            for (uint8_t b = 0; b < bytes; b += 1)
+            {
+                uint8_t edge = mask >> (24 - 8 * b);
+                uint8_t front = (text >> (24 - 8 * b)) & edge;
+                uint8_t back = ~front & edge;
+
+                line[b] = (line[b] & ~((front & textClear[parity]) | (back & backClear[parity]))) | (front & textSet[parity]) | (back & backSet[parity]);
+            }
+        }
+    }
+    else
+    {
+        // Each line is expanded to length * scale points, then written on scale lines
+        uint16_t lengthScaled = length * scale;
+        uint8_t bytes = (shift + lengthScaled + 7) / 8;
+        uint8_t edge1 = 0xff >> shift;
+        uint8_t edge2 = 0xff << ((8 - (shift + lengthScaled) % 8) % 8);
+        uint8_t data[24];
+        uint8_t shifted[25];
+
+        for (uint8_t n = 0; n < number; n += 1)
+        {
+            uint8_t count = s_scaleLine(lines[n], length, scale, data);
+
+            // Shifted to the first point, edges masked
+            for (uint8_t b = 0; b < bytes; b += 1)
+            {
+                uint8_t work = (b < count) ? (data[b] >> shift) : 0x00;
+                if ((b > 0) and (shift > 0))
+                {
+                    work |= data[b - 1] << (8 - shift);
+                }
+                shifted[b] = work;
+            }
+
+            for (uint8_t r = 0; r < scale; r += 1, lineX += stepX, line += stepLine)
+            {
+                uint8_t parity = lineX % 2;
+
+                for (uint8_t b = 0; b < bytes; b += 1)
+                {
+                    uint8_t edge = 0xff;
+                    if (b == 0)
+                    {
+                        edge &= edge1;
+                    }
+                    if (b == bytes - 1)
+                    {
+                        edge &= edge2;
+                    }
+                    uint8_t front = shifted[b] & edge;
+                    uint8_t back = ~front & edge;
+
+                    line[b] = (line[b] & ~((front & textClear[parity]) | (back & backClear[parity]))) | (front & textSet[parity]) | (back & backSet[parity]);
+                }
+            }
+        }
+    }
+
+#endif // FONT_MODE
+}
+
+void Screen_EPD_EXT3_Fast::s_drawLinesClipped(uint32_t lines[24], uint8_t number, uint8_t length, uint8_t scale,
+                                              int32_t lineX, int8_t stepX, int32_t pointY,
+                                              uint8_t textSet[2], uint8_t textClear[2], uint8_t backSet[2], uint8_t backClear[2])
+{
+    // Clip rectangle, physical coordinates
+    uint16_t clipX1 = v_clipX1;
+    uint16_t clipY1 = v_clipY1;
+    uint16_t clipX2 = v_clipX2 - 1;
+    uint16_t clipY2 = v_clipY2 - 1;
+    s_orientCoordinates(clipX1, clipY1);
+    s_orientCoordinates(clipX2, clipY2);
+    if (clipX1 > clipX2)
+    {
+        hV_HAL_swap(clipX1, clipX2);
+    }
+    if (clipY1 > clipY2)
+    {
+        hV_HAL_swap(clipY1, clipY2);
+    }
+
+    // Window of points along H, whole bytes with masked edges
+    int32_t window1 = hV_HAL_max(pointY, (int32_t)clipY1);
+    int32_t window2 = hV_HAL_min(pointY + length * scale - 1, (int32_t)clipY2);
+    uint16_t byte1 = window1 >> 3;
+    uint16_t byte2 = window2 >> 3;
+    uint8_t edge1 = 0xff >> (window1 & 0x07);
+    uint8_t edge2 = 0xff << (7 - (window2 & 0x07));
+
+    uint8_t data[24];
+    uint8_t count;
+
+    for (uint8_t n = 0; n < number; n += 1)
+    {
+        if (scale == 1)
+        {
+            for (count = 0; count < 4; count += 1)
+            {
+                data[count] = lines[n] >> (24 - 8 * count);
+            }
+        }
+        else
+        {
+            count = s_scaleLine(lines[n], length, scale, data);
+        }
+
+        for (uint8_t r = 0; r < scale; r += 1, lineX += stepX)
+        {
+            // Line outside the clip rectangle
+            if ((lineX < clipX1) or (lineX > clipX2))
+            {
+                continue;
+            }
+
+            uint8_t parity = lineX % 2;
+            uint8_t * line = s_newImage + lineX * u_bufferSizeH;
+            s_markDirty(lineX, lineX, window1, window2);
+
+            for (uint16_t b = byte1; b <= byte2; b += 1)
+            {
+                // Bits of data for the points of byte b
+                int16_t offset = 8 * b - pointY;
+                uint8_t work = 0x00;
+                if (offset < 0)
+                {
+                    work = data[0] >> -offset;
+                }
+                else
+                {
+                    uint8_t k = offset >> 3;
+                    uint8_t shift = offset & 0x07;
+                    if (k < count)
+                    {
+                        work = data[k] << shift;
+                    }
+                    if ((shift > 0) and (k + 1 < count))
+                    {
+                        work |= data[k + 1] >> (8 - shift);
+                    }
+                }
+
+                uint8_t edge = 0xff;
+                if (b == byte1)
+                {
+                    edge &= edge1;
+                }
+                if (b == byte2)
+                {
+                    edge &= edge2;
+                }
+                uint8_t front = work & edge;
+                uint8_t back = ~front & edge;
+
+                line[b] = (line[b] & ~((front & textClear[parity]) | (back & backClear[parity]))) | (front & textSet[parity]) | (back & backSet[parity]);
+            }
+        }
+    }
+}
+
+void Screen_EPD_EXT3_Fast::s_setOrientation(uint8_t orientation)
+{
+    s_foldDirtyPoints(); // with previous oriented writer
+    v_orientation = orientation % 4;
+
+    // Oriented writer, same as s_orientCoordinates()
+    int32_t line = u_bufferSizeH * 8; // bits per line
+    switch (v_orientation)
+    {
+        case 3: // x = V - 1 - x
+
+            s_orientSizeX = v_screenSizeV;
+            s_orientSizeY = v_screenSizeH;
+            s_orientOrigin = (v_screenSizeV - 1) * line;
+            s_orientStrideX = -line;
+            s_orientStrideY = 1;
+            s_orientParity = (v_screenSizeV - 1) % 2;
+            break;
+
+        case 2: // x = H - 1 - x, y = V - 1 - y, then swap
+
+            s_orientSizeX = v_screenSizeH;
+            s_orientSizeY = v_screenSizeV;
+            s_orientOrigin = (v_screenSizeV - 1) * line + (v_screenSizeH - 1);
+            s_orientStrideX = -1;
+            s_orientStrideY = -line;
+            s_orientParity = (v_screenSizeV + v_screenSizeH) % 2;
+            break;
+
+        case 1: // y = H - 1 - y
+
+            s_orientSizeX = v_screenSizeV;
+            s_orientSizeY = v_screenSizeH;
+            s_orientOrigin = v_screenSizeH - 1;
+            s_orientStrideX = line;
+            s_orientStrideY = -1;
+            s_orientParity = (v_screenSizeH - 1) % 2;
+            break;
+
+        default: // swap
+
+            s_orientSizeX = v_screenSizeH;
+            s_orientSizeY = v_screenSizeV;
+            s_orientOrigin = 0;
+            s_orientStrideX = 1;
+            s_orientStrideY = line;
+            s_orientParity = 0;
+            break;
+    }
+}
+
+void Screen_EPD_EXT3_Fast::s_getPhysical(int32_t x1, int32_t y1, int32_t & lineX, int32_t & pointY)
+{
+    switch (v_orientation)
+    {
+        case 3:
+
+            lineX = v_screenSizeV - 1 - x1;
+            pointY = y1;
+            break;
+
+        case 2:
+
+            lineX = v_screenSizeV - 1 - y1;
+            pointY = v_screenSizeH - 1 - x1;
+            break;
+
+        case 1:
+
+            lineX = x1;
+            pointY = v_screenSizeH - 1 - y1;
+            break;
+
+        default:
+
+            lineX = y1;
+            pointY = x1;
+            break;
+    }
+}
+
+bool Screen_EPD_EXT3_Fast::s_orientCoordinates(uint16_t & x, uint16_t & y)
+{
+    bool _flagResult = RESULT_ERROR;
+    switch (v_orientation)
+    {
+        case 3: // checked, previously 1
+
+            if ((x < v_screenSizeV) and (y < v_screenSizeH))
+            {
+                x = v_screenSizeV - 1 - x;
+                _flagResult = RESULT_SUCCESS;
+            }
+            break;
+
+        case 2: // checked
+
+            if ((x < v_screenSizeH) and (y < v_screenSizeV))
+            {
+                x = v_screenSizeH - 1 - x;
+                y = v_screenSizeV - 1 - y;
+                hV_HAL_swap(x, y);
+                _flagResult = RESULT_SUCCESS;
+            }
+            break;
+
+        case 1: // checked, previously 3
+
+            if ((x < v_screenSizeV) and (y < v_screenSizeH))
+            {
+                y = v_screenSizeH - 1 - y;
+                _flagResult = RESULT_SUCCESS;
+            }
+            break;
+
+        default: // checked
+
+            if ((x < v_screenSizeH) and (y < v_screenSizeV))
+            {
+                hV_HAL_swap(x, y);
+                _flagResult = RESULT_SUCCESS;
+            }
+            break;
+    }
+
+    return _flagResult;
+}
+
+uint32_t Screen_EPD_EXT3_Fast::s_getZ(uint16_t x1, uint16_t y1)
+{
+    uint32_t z1 = 0;
+    // According to 11.98 inch Spectra Application Note
+    // at http://www.pervasivedisplays.com/LiteratureRetrieve.aspx?ID=245146
+
+    z1 = (uint32_t)x1 * u_bufferSizeH + (y1 >> 3);
+
+    return z1;
+}
+
+uint16_t Screen_EPD_EXT3_Fast::s_getB(uint16_t x1, uint16_t y1)
+{
+    uint16_t b1 = 0;
+
+    b1 = 7 - (y1 % 8);
+
+    return b1;
+}
+
+uint16_t Screen_EPD_EXT3_Fast::s_getPoint(uint16_t x1, uint16_t y1)
+{
+    // Check coordinates are within screen, logical coordinates
+    if ((x1 >= s_orientSizeX) or (y1 >= s_orientSizeY))
+    {
+        return 0x0000;
+    }
+
+    // Coordinates, with oriented writer
+    uint32_t index = s_getIndex(x1, y1);
+    uint32_t z1 = index >> 3;
+    uint16_t b1 = 7 - (index & 0x07);
+
+    // Basic colours
+    if ((bitRead(s_newImage[z1], b1) == 1) xor u_invert)
+    {
+        return myColours.black;
+    }
+    else
+    {
+        return myColours.white;
+    }
+}
+//
+// === End of Class section
+//
+
+//
+// === Statistics section
+//
+uint16_t Screen_EPD_EXT3_Fast::readPoint(uint16_t x1, uint16_t y1)
+{
+    return s_getPoint(x1, y1);
+}
+
+uint32_t Screen_EPD_EXT3_Fast::getCountSetPoint()
+{
+    return s_countSetPoint;
+}
+
+void Screen_EPD_EXT3_Fast::resetCountSetPoint()
+{
+    s_countSetPoint = 0;
+}
+
+statistics_t Screen_EPD_EXT3_Fast::getFlushStatistics(uint8_t phase)
+{
+    statistics_t result;
+    resetStatistics(result);
+
+    if (phase < PHASE_NUMBER)
+    {
+        result = s_statisticsFlush[phase];
+    }
+    return result;
+}
+
+void Screen_EPD_EXT3_Fast::resetFlushStatistics()
+{
+    for (uint8_t phase = 0; phase < PHASE_NUMBER; phase += 1)
+    {
+        resetStatistics(s_statisticsFlush[phase]);
+    }
+}
+
+memory_t Screen_EPD_EXT3_Fast::getMemoryFootprint()
 {
-    clear(myColours.black);
-    flush();
-    delay(100);
+    memory_t result;
+
+    result.frameBuffer = (s_newImage != 0) ? u_pageColourSize * u_bufferDepth : 0;
+    result.object = sizeof(Screen_EPD_EXT3_Fast);
+    result.OTP = sizeof(COG_data);
+    result.buffers = sizeSharedBuffers();
+    result.fonts = f_sizeFontTables();
+    result.glyphCache = GLYPH_CACHE_SIZE; // worst case, allocated on first text and kept, 0 = no cache
+    result.RAM = result.frameBuffer + result.glyphCache + result.object + result.buffers;
+    result.flash = result.fonts;
+
+    return result;
+}
 
-    clear(myColours.white);
-    flush();
-    delay(100);
+uint32_t Screen_EPD_EXT3_Fast::getBeginProfile(uint8_t stage)
+{
+    return (stage < STAGE_NUMBER) ? s_profileBegin[stage] : 0;
 }
 
-void Screen_EPD_EXT3_Fast::s_setPoint(uint16_t x1, uint16_t y1, uint16_t colour)
+uint32_t Screen_EPD_EXT3_Fast::getFrameHash()
 {
-    // Orient and check coordinates are within screen
-    if (s_orientCoordinates(x1, y1) == RESULT_ERROR)
+    uint32_t result = 0x811c9dc5; // FNV-1a offset basis
+
+    if (s_newImage != 0)
     {
-        return;
+        for (uint32_t index = 0; index < u_pageColourSize; index += 1)
+        {
+            result ^= s_newImage[index];
+            result *= 0x01000193; // FNV-1a prime
+        }
     }
+    return result;
+}
 
-    // Convert combined colours into basic colours
-    bool flagOdd = ((x1 + y1) % 2 == 0);
+void Screen_EPD_EXT3_Fast::s_recordStage(uint8_t stage, uint32_t & chrono)
+{
+    uint32_t now = micros();
+    if (s_flagProfile)
+    {
+        s_profileBegin[stage] = now - chrono;
+    }
+    chrono = now;
+}
 
-    if (colour == myColours.grey)
+void Screen_EPD_EXT3_Fast::s_recordPhase(uint8_t phase, uint32_t & chrono)
+{
+    uint32_t now = micros();
+    updateStatistics(s_statisticsFlush[phase], now - chrono);
+    chrono = now;
+}
+//
+// === End of Statistics section
+//
+
+//
+// === Image section
+//
+uint32_t Screen_EPD_EXT3_Fast::getFrameSize()
+{
+    return u_pageColourSize;
+}
+
+bool Screen_EPD_EXT3_Fast::readFrame(uint8_t * frame, uint32_t size)
+{
+    if ((s_newImage == 0) or (size != u_pageColourSize))
+    {
+        return RESULT_ERROR;
+    }
+
+    uint8_t mask = (u_invert) ? 0xff : 0x00;
+    for (uint32_t index = 0; index < u_pageColourSize; index += 1)
+    {
+        frame[index] = s_newImage[index] ^ mask;
+    }
+    return RESULT_SUCCESS;
+}
+
+bool Screen_EPD_EXT3_Fast::writeFrame(const uint8_t * frame, uint32_t size)
+{
+    if ((s_newImage == 0) or (size != u_pageColourSize))
+    {
+        return RESULT_ERROR;
+    }
+
+    s_markDirty(0, v_screenSizeV - 1, 0, v_screenSizeH - 1);
+
+    if (u_invert)
     {
-        if (flagOdd)
+        for (uint32_t index = 0; index < u_pageColourSize; index += 1)
         {
-            colour = myColours.black; // black
+            s_newImage[index] = ~frame[index];
         }
-        else
+    }
+    else
+    {
+        memcpy(s_newImage, frame, u_pageColourSize);
+    }
+    return RESULT_SUCCESS;
+}
+
+uint16_t Screen_EPD_EXT3_Fast::getDirtyBand(uint16_t & firstLine, uint16_t & lastLine)
+{
+    s_mergeDirtyRegion();
+
+    if (s_dirtyFirst > s_dirtyLast)
+    {
+        firstLine = 0;
+        lastLine = 0;
+        return 0;
+    }
+
+    firstLine = s_dirtyFirst / u_bufferSizeH;
+    lastLine = s_dirtyLast / u_bufferSizeH;
+    return lastLine - firstLine + 1;
+}
+
+uint32_t Screen_EPD_EXT3_Fast::getDirtyRegion(uint16_t & x1, uint16_t & y1, uint16_t & x2, uint16_t & y2, uint8_t layout)
+{
+    s_foldDirtyPoints();
+
+    if (s_regionLine1 > s_regionLine2)
+    {
+        x1 = 0;
+        y1 = 0;
+        x2 = 0;
+        y2 = 0;
+        return 0;
+    }
+
+    // Physical coordinates, points along H as x and lines along V as y
+    x1 = s_regionPoint1;
+    y1 = s_regionLine1;
+    x2 = s_regionPoint2;
+    y2 = s_regionLine2;
+
+    if (layout == IMAGE_LOGICAL)
+    {
+        // Inverse of s_getPhysical()
+        switch (v_orientation)
         {
-            colour = myColours.white; // white
+            case 3:
+
+                x1 = v_screenSizeV - 1 - s_regionLine2;
+                y1 = s_regionPoint1;
+                x2 = v_screenSizeV - 1 - s_regionLine1;
+                y2 = s_regionPoint2;
+                break;
+
+            case 2:
+
+                x1 = v_screenSizeH - 1 - s_regionPoint2;
+                y1 = v_screenSizeV - 1 - s_regionLine2;
+                x2 = v_screenSizeH - 1 - s_regionPoint1;
+                y2 = v_screenSizeV - 1 - s_regionLine1;
+                break;
+
+            case 1:
+
+                x1 = s_regionLine1;
+                y1 = v_screenSizeH - 1 - s_regionPoint2;
+                x2 = s_regionLine2;
+                y2 = v_screenSizeH - 1 - s_regionPoint1;
+                break;
+
+            default:
+
+                break;
         }
     }
 
-    // Coordinates
-    uint32_t z1 = s_getZ(x1, y1);
-    uint16_t b1 = s_getB(x1, y1);
+    return (uint32_t)(x2 - x1 + 1) * (y2 - y1 + 1);
+}
 
-    // Basic colours
-    if ((colour == myColours.white) xor u_invert)
+void Screen_EPD_EXT3_Fast::resetDirtyRegion()
+{
+    s_mergeDirtyRegion();
+
+    s_regionLine1 = 0xffff; // clean
+    s_regionLine2 = 0;
+    s_regionPoint1 = 0xffff;
+    s_regionPoint2 = 0;
+}
+
+void Screen_EPD_EXT3_Fast::s_foldDirtyPoints()
+{
+    if (s_pointX1 <= s_pointX2)
     {
-        // physical black 0-0
-        bitClear(s_newImage[z1], b1);
+        // Physical corners from the bit index, line = index / bits per line
+        uint32_t bitsLine = u_bufferSizeH * 8;
+        uint32_t index1 = s_getIndex(s_pointX1, s_pointY1);
+        uint32_t index2 = s_getIndex(s_pointX2, s_pointY2);
+        uint16_t line1 = index1 / bitsLine;
+        uint16_t point1 = index1 % bitsLine;
+        uint16_t line2 = index2 / bitsLine;
+        uint16_t point2 = index2 % bitsLine;
+
+        s_markDirty(hV_HAL_min(line1, line2), hV_HAL_max(line1, line2), hV_HAL_min(point1, point2), hV_HAL_max(point1, point2));
+
+        s_pointX1 = 0xffff; // none
+        s_pointY1 = 0xffff;
+        s_pointX2 = 0;
+        s_pointY2 = 0;
     }
-    else if ((colour == myColours.black) xor u_invert)
+}
+
+void Screen_EPD_EXT3_Fast::s_mergeDirtyRegion()
+{
+    s_foldDirtyPoints();
+
+    if (s_regionLine1 <= s_regionLine2)
     {
-        // physical white 1-0
-        bitSet(s_newImage[z1], b1);
+        uint32_t first = (uint32_t)s_regionLine1 * u_bufferSizeH + (s_regionPoint1 >> 3);
+        uint32_t last = (uint32_t)s_regionLine2 * u_bufferSizeH + (s_regionPoint2 >> 3);
+
+        if (first < s_dirtyFirst)
+        {
+            s_dirtyFirst = first;
+        }
+        if (last > s_dirtyLast)
+        {
+            s_dirtyLast = last;
+        }
     }
 }
 
-void Screen_EPD_EXT3_Fast::s_setOrientation(uint8_t orientation)
+void Screen_EPD_EXT3_Fast::s_setClean()
 {
-    v_orientation = orientation % 4;
+    s_pointX1 = 0xffff; // none
+    s_pointY1 = 0xffff;
+    s_pointX2 = 0;
+    s_pointY2 = 0;
+
+    s_regionLine1 = 0xffff; // clean
+    s_regionLine2 = 0;
+    s_regionPoint1 = 0xffff;
+    s_regionPoint2 = 0;
+
+    s_dirtyFirst = 0xffffffff; // clean
+    s_dirtyLast = 0;
 }
 
-bool Screen_EPD_EXT3_Fast::s_orientCoordinates(uint16_t & x, uint16_t & y)
+void Screen_EPD_EXT3_Fast::s_copyDirtyBand()
 {
-    bool _flagResult = RESULT_ERROR;
+    s_mergeDirtyRegion();
+
+    if (s_dirtyFirst <= s_dirtyLast)
+    {
+        memcpy(s_newImage + u_pageColourSize + s_dirtyFirst, s_newImage + s_dirtyFirst, s_dirtyLast - s_dirtyFirst + 1);
+    }
+
+    s_setClean();
+    s_flagDisplayed = true;
+}
+
+bool Screen_EPD_EXT3_Fast::s_isUnchanged()
+{
+    if (s_flagDisplayed == false)
+    {
+        return false;
+    }
+
+    s_mergeDirtyRegion();
+
+    if (s_dirtyFirst <= s_dirtyLast)
+    {
+        if (memcmp(s_newImage + u_pageColourSize + s_dirtyFirst, s_newImage + s_dirtyFirst, s_dirtyLast - s_dirtyFirst + 1) != 0)
+        {
+            return false;
+        }
+
+        s_setClean();
+    }
+
+    return true;
+}
+
+// Bit reversal for bitmaps, one nibble
+const uint8_t reverseNibble[16] =
+{
+    0x0, 0x8, 0x4, 0xc, 0x2, 0xa, 0x6, 0xe, 0x1, 0x9, 0x5, 0xd, 0x3, 0xb, 0x7, 0xf
+};
+
+void Screen_EPD_EXT3_Fast::s_getBitmapBlock(const uint8_t * bitmap, uint16_t bytesX, uint16_t sizeY, uint16_t column, int32_t band, bool flagReverse, uint8_t columns[8])
+{
+    uint8_t rows[8];
+    int32_t row = band * 8;
+
+    for (uint8_t index = 0; index < 8; index += 1, row += 1)
+    {
+        rows[index] = ((row >= 0) and (row < sizeY)) ? bitmap[row * bytesX + column] : 0x00;
+    }
+
+    // Transpose 8 x 8 points, as two words of 4 rows
+    uint32_t high = ((uint32_t)rows[0] << 24) | ((uint32_t)rows[1] << 16) | ((uint32_t)rows[2] << 8) | rows[3];
+    uint32_t low = ((uint32_t)rows[4] << 24) | ((uint32_t)rows[5] << 16) | ((uint32_t)rows[6] << 8) | rows[7];
+    uint32_t work;
+
+    work = (high ^ (high >> 7)) & 0x00aa00aa;
+    high = high ^ work ^ (work << 7);
+    work = (low ^ (low >> 7)) & 0x00aa00aa;
+    low = low ^ work ^ (work << 7);
+
+    work = (high ^ (high >> 14)) & 0x0000cccc;
+    high = high ^ work ^ (work << 14);
+    work = (low ^ (low >> 14)) & 0x0000cccc;
+    low = low ^ work ^ (work << 14);
+
+    work = (high & 0xf0f0f0f0) | ((low >> 4) & 0x0f0f0f0f);
+    low = ((high << 4) & 0xf0f0f0f0) | (low & 0x0f0f0f0f);
+    high = work;
+
+    for (uint8_t index = 0; index < 4; index += 1)
+    {
+        columns[index] = high >> (24 - 8 * index);
+        columns[index + 4] = low >> (24 - 8 * index);
+    }
+
+    if (flagReverse)
+    {
+        for (uint8_t index = 0; index < 8; index += 1)
+        {
+            columns[index] = (reverseNibble[columns[index] & 0x0f] << 4) | reverseNibble[columns[index] >> 4];
+        }
+    }
+}
+
+void Screen_EPD_EXT3_Fast::drawBitmap(uint16_t x0, uint16_t y0, const uint8_t * bitmap, uint16_t sizeX, uint16_t sizeY, uint8_t operation)
+{
+    // Bitmap box, coordinates beyond 0x7fff are negative, as wrapped by uint16_t arithmetic
+    int32_t boxX1 = (int16_t)x0;
+    int32_t boxY1 = (int16_t)y0;
+    int32_t boxX2 = boxX1 + sizeX - 1;
+    int32_t boxY2 = boxY1 + sizeY - 1;
+
+    if ((s_newImage == 0) or (sizeX == 0) or (sizeY == 0) or s_isClipped(boxX1, boxY1, boxX2, boxY2))
+    {
+        return;
+    }
+
+    // Visible part of the bitmap, logical coordinates
+    int32_t visibleX1 = hV_HAL_max(boxX1, (int32_t)v_clipX1);
+    int32_t visibleY1 = hV_HAL_max(boxY1, (int32_t)v_clipY1);
+    int32_t visibleX2 = hV_HAL_min(boxX2, (int32_t)v_clipX2 - 1);
+    int32_t visibleY2 = hV_HAL_min(boxY2, (int32_t)v_clipY2 - 1);
+
+    // Window of points along H, whole bytes with masked edges
+    int32_t lineX1, pointY1, lineX2, pointY2;
+    s_getPhysical(visibleX1, visibleY1, lineX1, pointY1);
+    s_getPhysical(visibleX2, visibleY2, lineX2, pointY2);
+    int32_t window1 = hV_HAL_min(pointY1, pointY2);
+    int32_t window2 = hV_HAL_max(pointY1, pointY2);
+    uint16_t byte1 = window1 >> 3;
+    uint16_t byte2 = window2 >> 3;
+    uint8_t edge1 = 0xff >> (window1 & 0x07);
+    uint8_t edge2 = 0xff << (7 - (window2 & 0x07));
+    s_markDirty(hV_HAL_min(lineX1, lineX2), hV_HAL_max(lineX1, lineX2), window1, window2);
+
+    // Rows or columns of the bitmap as physical lines, stream of bytes from the first point
+    uint16_t bytesX = (sizeX + 7) / 8; // bytes per row
+    uint16_t bytesY = (sizeY + 7) / 8; // bands of 8 rows
+    int32_t lineX; // line of the top left point, along V
+    int32_t pointY; // first point of the stream, along H
+    s_getPhysical(boxX1, boxY1, lineX, pointY);
+    int8_t stepX; // next row or column, along V
+    bool flagReverse; // stream from the last point
+
     switch (v_orientation)
     {
-        case 3: // checked, previously 1
+        case 3: // column = line, row j = point + j
 
-            if ((x < v_screenSizeV) and (y < v_screenSizeH))
-            {
-                x = v_screenSizeV - 1 - x;
-                _flagResult = RESULT_SUCCESS;
-            }
+            stepX = -1;
+            flagReverse = false;
             break;
 
-        case 2: // checked
+        case 2: // row = line, column i = point - i
 
-            if ((x < v_screenSizeH) and (y < v_screenSizeV))
-            {
-                x = v_screenSizeH - 1 - x;
-                y = v_screenSizeV - 1 - y;
-                hV_HAL_swap(x, y);
-                _flagResult = RESULT_SUCCESS;
-            }
+            stepX = -1;
+            flagReverse = true;
+            pointY -= bytesX * 8 - 1;
             break;
 
-        case 1: // checked, previously 3
+        case 1: // column = line, row j = point - j
 
-            if ((x < v_screenSizeV) and (y < v_screenSizeH))
-            {
-                y = v_screenSizeH - 1 - y;
-                _flagResult = RESULT_SUCCESS;
-            }
+            stepX = 1;
+            flagReverse = true;
+            pointY -= bytesY * 8 - 1;
             break;
 
-        default: // checked
+        default: // row = line, column i = point + i
 
-            if ((x < v_screenSizeH) and (y < v_screenSizeV))
+            stepX = 1;
+            flagReverse = false;
+            break;
+    }
+
+    // Byte b of the line takes the end of byte k - 1 and the start of byte k of the stream
+    uint8_t shift = pointY & 0x07;
+    int32_t first = (pointY - shift) / 8; // byte of the line for byte 0 of the stream
+
+    if ((v_orientation == 0) or (v_orientation == 2))
+    {
+        for (int32_t y = visibleY1; y <= visibleY2; y += 1)
+        {
+            const uint8_t * row = bitmap + (y - boxY1) * bytesX;
+            uint8_t * line = s_newImage + (lineX + stepX * (y - boxY1)) * u_bufferSizeH;
+            uint8_t previous = 0x00;
+            uint8_t current;
+
+            for (int32_t b = byte1 - 1; b <= byte2; b += 1)
             {
-                hV_HAL_swap(x, y);
-                _flagResult = RESULT_SUCCESS;
+                int32_t k = b - first;
+                current = 0x00;
+                if ((k >= 0) and (k < bytesX) and flagReverse)
+                {
+                    current = row[bytesX - 1 - k];
+                    current = (reverseNibble[current & 0x0f] << 4) | reverseNibble[current >> 4];
+                }
+                else if ((k >= 0) and (k < bytesX))
+                {
+                    current = row[k];
+                }
+
+                if (b >= byte1)
+                {
+                    uint8_t edge = 0xff;
+                    if (b == byte1)
+                    {
+                        edge &= edge1;
+                    }
+                    if (b == byte2)
+                    {
+                        edge &= edge2;
+                    }
+                    s_writeRaster(line + b, (previous << (8 - shift)) | (current >> shift), edge, operation);
+                }
+                previous = current;
             }
-            break;
+        }
     }
+    else
+    {
+        uint8_t previous[8];
+        uint8_t current[8];
 
-    return _flagResult;
+        for (uint16_t column = (visibleX1 - boxX1) / 8; column <= (visibleX2 - boxX1) / 8; column += 1)
+        {
+            for (int32_t b = byte1 - 1; b <= byte2; b += 1)
+            {
+                int32_t k = b - first;
+                s_getBitmapBlock(bitmap, bytesX, sizeY, column, (flagReverse) ? bytesY - 1 - k : k, flagReverse, current);
+
+                if (b >= byte1)
+                {
+                    uint8_t edge = 0xff;
+                    if (b == byte1)
+                    {
+                        edge &= edge1;
+                    }
+                    if (b == byte2)
+                    {
+                        edge &= edge2;
+                    }
+
+                    for (uint8_t index = 0; index < 8; index += 1)
+                    {
+                        int32_t x = boxX1 + column * 8 + index;
+                        if ((x >= visibleX1) and (x <= visibleX2))
+                        {
+                            uint8_t * line = s_newImage + (lineX + stepX * (x - boxX1)) * u_bufferSizeH;
+                            s_writeRaster(line + b, (previous[index] << (8 - shift)) | (current[index] >> shift), edge, operation);
+                        }
+                    }
+                }
+                memcpy(previous, current, 8);
+            }
+        }
+    }
 }
 
-uint32_t Screen_EPD_EXT3_Fast::s_getZ(uint16_t x1, uint16_t y1)
+#if defined(hV_HAL_HOST)
+
+bool Screen_EPD_EXT3_Fast::saveFrame(const char * fileName, uint8_t format, uint8_t layout)
 {
-    uint32_t z1 = 0;
-    // According to 11.98 inch Spectra Application Note
-    // at http://www.pervasivedisplays.com/LiteratureRetrieve.aspx?ID=245146
+    if (s_newImage == 0)
+    {
+        return RESULT_ERROR;
+    }
 
-    z1 = (uint32_t)x1 * u_bufferSizeH + (y1 >> 3);
+    bool result = RESULT_ERROR;
 
-    return z1;
+    if (layout == IMAGE_NATIVE)
+    {
+        uint8_t * frame = (uint8_t *)malloc(u_pageColourSize);
+        readFrame(frame, u_pageColourSize);
+        if (hV_HAL_Host_writeImage(fileName, format, frame, u_bufferSizeH * 8, u_bufferSizeV))
+        {
+            result = RESULT_SUCCESS;
+        }
+        free(frame);
+    }
+    else
+    {
+        uint16_t sizeX = screenSizeX();
+        uint16_t sizeY = screenSizeY();
+        uint16_t bytesX = (sizeX + 7) / 8;
+        uint8_t * frame = (uint8_t *)calloc(bytesX * sizeY, 1);
+
+        for (uint16_t y = 0; y < sizeY; y += 1)
+        {
+            for (uint16_t x = 0; x < sizeX; x += 1)
+            {
+                if (s_getPoint(x, y) == myColours.black)
+                {
+                    bitSet(frame[y * bytesX + x / 8], 7 - x % 8);
+                }
+            }
+        }
+        if (hV_HAL_Host_writeImage(fileName, format, frame, sizeX, sizeY))
+        {
+            result = RESULT_SUCCESS;
+        }
+        free(frame);
+    }
+    return result;
 }
 
-uint16_t Screen_EPD_EXT3_Fast::s_getB(uint16_t x1, uint16_t y1)
+bool Screen_EPD_EXT3_Fast::loadFrame(const char * fileName, uint8_t layout)
 {
-    uint16_t b1 = 0;
+    if (s_newImage == 0)
+    {
+        return RESULT_ERROR;
+    }
 
-    b1 = 7 - (y1 % 8);
+    bool result = RESULT_ERROR;
 
-    return b1;
-}
+    if (layout == IMAGE_NATIVE)
+    {
+        uint8_t * frame = (uint8_t *)malloc(u_pageColourSize);
+        if (hV_HAL_Host_readImage(fileName, frame, u_bufferSizeH * 8, u_bufferSizeV))
+        {
+            result = writeFrame(frame, u_pageColourSize);
+        }
+        free(frame);
+    }
+    else
+    {
+        uint16_t sizeX = screenSizeX();
+        uint16_t sizeY = screenSizeY();
+        uint16_t bytesX = (sizeX + 7) / 8;
+        uint8_t * frame = (uint8_t *)malloc(bytesX * sizeY);
 
-uint16_t Screen_EPD_EXT3_Fast::s_getPoint(uint16_t x1, uint16_t y1)
-{
-    return 0x0000;
+        if (hV_HAL_Host_readImage(fileName, frame, sizeX, sizeY))
+        {
+            for (uint16_t y = 0; y < sizeY; y += 1)
+            {
+                for (uint16_t x = 0; x < sizeX; x += 1)
+                {
+                    bool flag = bitRead(frame[y * bytesX + x / 8], 7 - x % 8);
+                    s_setPoint(x, y, (flag) ? myColours.black : myColours.white);
+                }
+            }
+            result = RESULT_SUCCESS;
+        }
+        free(frame);
+    }
+    return result;
 }
+
+#endif // hV_HAL_HOST
 //
-// === End of Class section
+// === End of Image section
 //
 
 //
@@ -1636,6 +3457,8 @@ void Screen_EPD_EXT3_Fast::s_getRawTouch(uint16_t & x0, uint16_t & y0, uint16_t
             }
         }
     } // u_codeSize
+
+    hV_HAL_TRACE(TRACE_TOUCH, ((uint32_t)t0 << 24) | ((uint32_t)(x0 & 0x0fff) << 12) | (y0 & 0x0fff));
 }
 
 bool Screen_EPD_EXT3_Fast::s_getInterruptTouch()
@@ -175,11 +175,224 @@ class Screen_EPD_EXT3_Fast final : public hV_Screen_Buffer, public hV_Utilities_
     /// @brief Update the display
     /// @details Display next frame-buffer on screen and copy next frame-buffer into old frame-buffer
     /// @param updateMode expected update mode, default = UPDATE_FAST
-    /// @return uint8_t recommended mode
+    /// @return uint8_t recommended mode, or UPDATE_UNCHANGED if no refresh was needed
     /// @note Mode checked with checkTemperatureMode()
+    /// @n A frame identical to the displayed one returns UPDATE_UNCHANGED
+    /// without powering the panel, see s_isUnchanged()
     ///
     uint8_t flushMode(uint8_t updateMode = UPDATE_FAST);
 
+    ///
+    /// @brief Update a region of the display, fast update
+    /// @details Send and refresh only the window of the panel around the region,
+    /// then copy the window of next frame-buffer into old frame-buffer
+    /// @param x0 top left coordinate, x-axis
+    /// @param y0 top left coordinate, y-axis
+    /// @param dx length, x-axis
+    /// @param dy height, y-axis
+    /// @return uint8_t UPDATE_FAST, UPDATE_UNCHANGED if no refresh was needed
+    /// or UPDATE_NONE for an empty region, otherwise as flushMode()
+    /// @note Medium screens only, e.g. 3.43"
+    /// @n The window is rounded to bytes along H and to pairs of lines along V
+    /// @n Falls back to flushMode() for other screens, when fast update is not available,
+    /// or before the first flush
+    /// @n Points written outside the region remain for the next flush
+    ///
+    uint8_t flushRegion(uint16_t x0, uint16_t y0, uint16_t dx, uint16_t dy);
+
+    ///
+    /// @brief Update the display, non-blocking
+    /// @details Send the image data, then start the update of the panel,
+    /// which continues with poll()
+    /// @param updateMode expected update mode, default = UPDATE_FAST
+    /// @param callback function called when the update is done, default = none
+    /// @return uint8_t recommended mode, UPDATE_UNCHANGED if no refresh was needed,
+    /// or UPDATE_NONE if an update is in progress
+    /// @note Mode checked with checkTemperatureMode()
+    /// @n The frame-buffer can be changed as soon as flushAsync() returns
+    /// @n Other updates complete the update in progress before starting
+    ///
+    uint8_t flushAsync(uint8_t updateMode = UPDATE_FAST, void (*callback)() = 0);
+
+    ///
+    /// @brief Continue the update started by flushAsync()
+    /// @return true if done, false if in progress
+    /// @note Call often from loop() or from a timer, the waits are checked without blocking
+    ///
+    bool poll();
+
+    ///
+    /// @brief Check whether the update started by flushAsync() is done
+    /// @return true if done
+    ///
+    bool isFlushDone();
+
+    ///
+    /// @brief Progress of the update started by flushAsync()
+    /// @return PHASE_UPDATE, PHASE_POWER_OFF or PHASE_FLUSH if done
+    ///
+    uint8_t getFlushPhase();
+
+    //
+    // === Statistics section
+    //
+    ///
+    /// @brief Read a point from the frame-buffer
+    /// @param x1 x coordinate
+    /// @param y1 y coordinate
+    /// @return colour 16-bit colour, black or white
+    /// @n @b More: @ref Colour, @ref Coordinate
+    ///
+    uint16_t readPoint(uint16_t x1, uint16_t y1);
+
+    ///
+    /// @brief Number of points set
+    /// @return number of calls to s_setPoint() since begin() or resetCountSetPoint()
+    /// @note Used to benchmark the graphics primitives
+    ///
+    uint32_t getCountSetPoint();
+
+    ///
+    /// @brief Reset the number of points set
+    ///
+    void resetCountSetPoint();
+
+    ///
+    /// @brief Get statistics for one phase of flush
+    /// @param phase PHASE_RESUME, PHASE_INITIAL, PHASE_SEND_IMAGE, PHASE_UPDATE, PHASE_POWER_OFF, PHASE_WAIT_BUSY or PHASE_FLUSH
+    /// @return statistics in us, with count, minimum, maximum and mean
+    /// @note PHASE_WAIT_BUSY cumulates the time spent in b_waitBusy() during each flush
+    ///
+    statistics_t getFlushStatistics(uint8_t phase);
+
+    ///
+    /// @brief Reset statistics for all phases of flush
+    ///
+    void resetFlushStatistics();
+
+    ///
+    /// @brief Get the memory footprint
+    /// @return memory footprint in bytes, for the selected screen
+    /// @note Call after begin(), as the frame-buffer is allocated by begin()
+    /// @note The glyph cache is counted when compiled in, even before its allocation
+    /// @note Font tables are constant, in RAM on some MCUs
+    ///
+    memory_t getMemoryFootprint();
+
+    ///
+    /// @brief Get the profile of begin()
+    /// @param stage STAGE_CONFIGURATION, STAGE_REPORT, STAGE_FRAME_BUFFER, STAGE_RESET, STAGE_OTP, STAGE_SPI, STAGE_FONTS, STAGE_TOUCH or STAGE_BEGIN
+    /// @return duration of the stage in us, during the last begin()
+    ///
+    uint32_t getBeginProfile(uint8_t stage);
+
+    ///
+    /// @brief Get the hash of the frame-buffer
+    /// @return 32-bit FNV-1a hash of the next image
+    /// @note Used to check frames against reference, independent from the orientation
+    ///
+    uint32_t getFrameHash();
+    //
+    // === End of Statistics section
+    //
+
+    //
+    // === Image section
+    //
+    ///
+    /// @brief Size of the image in panel-native layout
+    /// @return size in bytes, same as one page of the frame-buffer
+    ///
+    uint32_t getFrameSize();
+
+    ///
+    /// @brief Copy the frame-buffer into an image, panel-native layout
+    /// @param frame image, 1 bit per pixel, 1 = black
+    /// @param size size of the image in bytes, as per getFrameSize()
+    /// @return RESULT_SUCCESS = false = success, RESULT_ERROR = true = error
+    ///
+    bool readFrame(uint8_t * frame, uint32_t size);
+
+    ///
+    /// @brief Copy an image into the frame-buffer, panel-native layout
+    /// @param frame image, 1 bit per pixel, 1 = black
+    /// @param size size of the image in bytes, as per getFrameSize()
+    /// @return RESULT_SUCCESS = false = success, RESULT_ERROR = true = error
+    /// @note Fast path for pre-rendered artwork, with one copy instead of drawing
+    ///
+    bool writeFrame(const uint8_t * frame, uint32_t size);
+
+    ///
+    /// @brief Draw bitmap, 1 bit per pixel
+    /// @param x0 top left coordinate, x-axis
+    /// @param y0 top left coordinate, y-axis
+    /// @param bitmap rows of sizeX pixels, each row padded to a whole byte, first pixel = MSB, 1 = black
+    /// @param sizeX width of the bitmap, x-axis
+    /// @param sizeY height of the bitmap, y-axis
+    /// @param operation BITMAP_COPY, BITMAP_OR, BITMAP_AND, BITMAP_XOR or BITMAP_NOT, default = BITMAP_COPY
+    /// @note Each physical line is written byte per byte, shifted to the first point,
+    /// with masked edge bytes and clipped to the clip rectangle
+    /// @n Rows are physical lines for orientations 0 and 2,
+    /// columns are transposed by blocks of 8 x 8 points for orientations 1 and 3
+    ///
+    void drawBitmap(uint16_t x0, uint16_t y0, const uint8_t * bitmap, uint16_t sizeX, uint16_t sizeY, uint8_t operation = BITMAP_COPY);
+
+    ///
+    /// @brief Dirty band, physical lines written since the last flush
+    /// @param[out] firstLine first line, along V
+    /// @param[out] lastLine last line, along V
+    /// @return number of lines, 0 = clean, same as the displayed frame
+    /// @note Written lines may hold the same values as before
+    ///
+    uint16_t getDirtyBand(uint16_t & firstLine, uint16_t & lastLine);
+
+    ///
+    /// @brief Dirty region, bounding box of the points written since the last flush or reset
+    /// @param[out] x1 top left coordinate, x-axis
+    /// @param[out] y1 top left coordinate, y-axis
+    /// @param[out] x2 bottom right coordinate, x-axis, included
+    /// @param[out] y2 bottom right coordinate, y-axis, included
+    /// @param layout IMAGE_LOGICAL for the current orientation
+    /// or IMAGE_NATIVE for physical points along H and lines along V, default = IMAGE_LOGICAL
+    /// @return number of points of the bounding box, 0 = clean
+    /// @note Written points may hold the same values as before
+    ///
+    uint32_t getDirtyRegion(uint16_t & x1, uint16_t & y1, uint16_t & x2, uint16_t & y2, uint8_t layout = IMAGE_LOGICAL);
+
+    ///
+    /// @brief Reset the dirty region
+    /// @note The next flush still updates the points written before the reset,
+    /// see getDirtyBand()
+    ///
+    void resetDirtyRegion();
+
+#if defined(hV_HAL_HOST)
+
+    ///
+    /// @brief Save the frame-buffer into a file, host only
+    /// @param fileName name of the file
+    /// @param format HOST_IMAGE_PBM or HOST_IMAGE_PNG
+    /// @param layout IMAGE_NATIVE or IMAGE_LOGICAL, default = IMAGE_LOGICAL
+    /// @return RESULT_SUCCESS = false = success, RESULT_ERROR = true = error
+    /// @note IMAGE_NATIVE has v_screenSizeV lines of v_screenSizeH pixels,
+    /// IMAGE_LOGICAL has screenSizeY() lines of screenSizeX() pixels
+    ///
+    bool saveFrame(const char * fileName, uint8_t format = HOST_IMAGE_PBM, uint8_t layout = IMAGE_LOGICAL);
+
+    ///
+    /// @brief Load the frame-buffer from a file, host only
+    /// @param fileName name of the file, PBM binary P4 only
+    /// @param layout IMAGE_NATIVE or IMAGE_LOGICAL, default = IMAGE_LOGICAL
+    /// @return RESULT_SUCCESS = false = success, RESULT_ERROR = true = error
+    /// @note The size of the image should match the layout
+    ///
+    bool loadFrame(const char * fileName, uint8_t layout = IMAGE_LOGICAL);
+
+#endif // hV_HAL_HOST
+    //
+    // === End of Image section
+    //
+
   protected:
     /// @cond
 
@@ -198,6 +411,135 @@ class Screen_EPD_EXT3_Fast final : public hV_Screen_Buffer, public hV_Utilities_
     ///
     bool s_orientCoordinates(uint16_t & x, uint16_t & y); // compulsory
 
+    ///
+    /// @brief Oriented writer, set by s_setOrientation()
+    /// @details Bit index in one page = origin + x * strideX + y * strideY,
+    /// then z = index / 8 and bit = 7 - index % 8
+    ///
+    int32_t s_orientOrigin, s_orientStrideX, s_orientStrideY;
+    uint16_t s_orientSizeX, s_orientSizeY; // logical sizes
+    uint8_t s_orientParity; // added to x + y for physical parity, grey
+
+    ///
+    /// @brief Dirty band, bytes of the page written since the last flush
+    /// @details Outside the band and the dirty region, next and previous pages are equal
+    /// @n s_dirtyFirst > s_dirtyLast = clean
+    ///
+    uint32_t s_dirtyFirst, s_dirtyLast;
+
+    ///
+    /// @brief Dirty region, physical points written since the last flush or reset
+    /// @details Merged into the dirty band by s_mergeDirtyRegion()
+    /// @n s_regionLine1 > s_regionLine2 = clean
+    ///
+    uint16_t s_regionLine1, s_regionLine2; // lines, along V
+    uint16_t s_regionPoint1, s_regionPoint2; // points, along H
+
+    ///
+    /// @brief Add points to the dirty region, physical coordinates
+    /// @param line1 first line, along V
+    /// @param line2 last line, along V, line2 >= line1
+    /// @param point1 first point, along H
+    /// @param point2 last point, along H, point2 >= point1
+    ///
+    inline void s_markDirty(uint16_t line1, uint16_t line2, uint16_t point1, uint16_t point2)
+    {
+        if (line1 < s_regionLine1)
+        {
+            s_regionLine1 = line1;
+        }
+        if (line2 > s_regionLine2)
+        {
+            s_regionLine2 = line2;
+        }
+        if (point1 < s_regionPoint1)
+        {
+            s_regionPoint1 = point1;
+        }
+        if (point2 > s_regionPoint2)
+        {
+            s_regionPoint2 = point2;
+        }
+    }
+
+    ///
+    /// @brief Points written by s_setPoint(), logical coordinates
+    /// @details Folded into the dirty region by s_foldDirtyPoints()
+    /// @n s_pointX1 > s_pointX2 = none
+    ///
+    uint16_t s_pointX1, s_pointY1, s_pointX2, s_pointY2;
+
+    ///
+    /// @brief Add one point to the dirty points, logical coordinates
+    /// @param x1 x coordinate, checked
+    /// @param y1 y coordinate, checked
+    /// @note Cheaper than s_markDirty() for one point
+    ///
+    inline void s_markPoint(uint16_t x1, uint16_t y1)
+    {
+        // Write only when the point is outside, most points are inside
+        if ((x1 < s_pointX1) or (x1 > s_pointX2) or (y1 < s_pointY1) or (y1 > s_pointY2))
+        {
+            s_pointX1 = hV_HAL_min(s_pointX1, x1);
+            s_pointX2 = hV_HAL_max(s_pointX2, x1);
+            s_pointY1 = hV_HAL_min(s_pointY1, y1);
+            s_pointY2 = hV_HAL_max(s_pointY2, y1);
+        }
+    }
+
+    ///
+    /// @brief Fold the dirty points into the dirty region
+    /// @note Uses the oriented writer, so call before changing orientation
+    ///
+    void s_foldDirtyPoints();
+
+    ///
+    /// @brief Merge the dirty region into the dirty band, the region is kept
+    ///
+    void s_mergeDirtyRegion();
+
+    ///
+    /// @brief Set the dirty region and the dirty band as clean
+    ///
+    void s_setClean();
+
+    ///
+    /// @brief Copy the dirty band of the next page into the previous page
+    /// @note Called after the image data are sent, the band is then clean
+    ///
+    void s_copyDirtyBand();
+
+    ///
+    /// @brief Check whether the next page matches the displayed frame
+    /// @return true if unchanged, then the dirty band is clean
+    /// @note Compares the dirty band only
+    /// @n Always false before the first flush, as the panel content is unknown
+    ///
+    bool s_isUnchanged();
+
+    bool s_flagDisplayed; // previous page = panel content
+
+    ///
+    /// @brief Bit index of a point, logical coordinates
+    /// @param x1 x coordinate, checked
+    /// @param y1 y coordinate, checked
+    /// @return bit index in one page of s_newImage[]
+    ///
+    inline uint32_t s_getIndex(uint16_t x1, uint16_t y1)
+    {
+        return s_orientOrigin + (int32_t)x1 * s_orientStrideX + (int32_t)y1 * s_orientStrideY;
+    }
+
+    ///
+    /// @brief Physical coordinates of a point, logical coordinates
+    /// @param x1 x coordinate, not checked, may be outside the screen
+    /// @param y1 y coordinate, not checked, may be outside the screen
+    /// @param[out] lineX line, along V
+    /// @param[out] pointY point of the line, along H
+    /// @note Same as s_orientCoordinates() without check
+    ///
+    void s_getPhysical(int32_t x1, int32_t y1, int32_t & lineX, int32_t & pointY);
+
     // Write and Read
     /// @brief Set point
     /// @param x1 x coordinate
@@ -207,6 +549,187 @@ class Screen_EPD_EXT3_Fast final : public hV_Screen_Buffer, public hV_Utilities_
     ///
     void s_setPoint(uint16_t x1, uint16_t y1, uint16_t colour);
 
+    ///
+    /// @brief Fill a rectangle, logical coordinates
+    /// @param x1 top left coordinate, x-axis
+    /// @param y1 top left coordinate, y-axis
+    /// @param x2 bottom right coordinate, x-axis, x2 >= x1
+    /// @param y2 bottom right coordinate, y-axis, y2 >= y1
+    /// @param colour 16-bit colour
+    /// @note Rectangle is clipped to the clip rectangle
+    ///
+    void s_fillRectangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t colour);
+
+    ///
+    /// @brief Fill a rectangle, physical coordinates
+    /// @param x1 first line, along V
+    /// @param y1 first point of the line, along H
+    /// @param x2 last line, along V, x2 >= x1
+    /// @param y2 last point of the line, along H, y2 >= y1
+    /// @param colour 16-bit colour
+    /// @note Each line is written byte per byte, with masked edge bytes
+    /// @warning No check on coordinates
+    ///
+    void s_fillPhysical(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t colour);
+
+    ///
+    /// @brief Masks for a colour, physical coordinates
+    /// @param colour 16-bit colour
+    /// @param[out] maskSet bits to set, for even and odd lines
+    /// @param[out] maskClear bits to clear, for even and odd lines
+    /// @note Grey alternates between lines, other colours than black and white leave bits unchanged
+    ///
+    void s_getColourMasks(uint16_t colour, uint8_t maskSet[2], uint8_t maskClear[2]);
+
+    ///
+    /// @brief Draw a character of the selected font, logical coordinates
+    /// @param x0 top left coordinate, x-axis
+    /// @param y0 top left coordinate, y-axis
+    /// @param character character index, 0 = space
+    /// @param textColour 16-bit colour
+    /// @param backColour 16-bit colour, only if font is solid
+    /// @note Each column or row of the character is written as one physical line
+    /// of up to 4 bytes, with text and background in the same pass
+    /// @n Same as s_drawCharacterScaled() with scale 1
+    ///
+    void s_drawCharacter(uint16_t x0, uint16_t y0, uint8_t character, uint16_t textColour, uint16_t backColour);
+
+    ///
+    /// @brief Draw a character of the selected font, scaled, logical coordinates
+    /// @param x0 top left coordinate, x-axis
+    /// @param y0 top left coordinate, y-axis
+    /// @param character character index, 0 = space
+    /// @param scale integer scale, 1..8
+    /// @param textColour 16-bit colour
+    /// @param backColour 16-bit colour, only if font is solid
+    /// @note Each physical line of the character is expanded by s_scaleLine()
+    /// and written on scale lines, with text and background in the same pass
+    /// @n Character partly outside the clip rectangle calls s_drawLinesClipped()
+    ///
+    void s_drawCharacterScaled(uint16_t x0, uint16_t y0, uint8_t character, uint8_t scale, uint16_t textColour, uint16_t backColour);
+
+    ///
+    /// @brief Write the physical lines of a character, clipped
+    /// @param lines one word per line, bit 31 = first point along H
+    /// @param number number of lines
+    /// @param length points per line
+    /// @param scale integer scale, 1..8
+    /// @param lineX first line, along V, may be outside the screen
+    /// @param stepX next line, +1 or -1
+    /// @param pointY first point of the lines, along H, may be outside the screen
+    /// @param textSet text masks, see s_getColourMasks()
+    /// @param textClear text masks
+    /// @param backSet background masks
+    /// @param backClear background masks
+    /// @note Lines outside the clip rectangle are skipped,
+    /// points are limited to a window of whole bytes with masked edges
+    ///
+    void s_drawLinesClipped(uint32_t lines[24], uint8_t number, uint8_t length, uint8_t scale,
+                            int32_t lineX, int8_t stepX, int32_t pointY,
+                            uint8_t textSet[2], uint8_t textClear[2], uint8_t backSet[2], uint8_t backClear[2]);
+
+    ///
+    /// @brief Columns of a block of 8 x 8 points of a bitmap
+    /// @param bitmap bitmap, as per drawBitmap()
+    /// @param bytesX bytes per row
+    /// @param sizeY height of the bitmap
+    /// @param column byte of the row, 8 columns
+    /// @param band 8 rows, outside the bitmap = white
+    /// @param flagReverse true = last row as MSB
+    /// @param[out] columns one byte per column, first row = MSB
+    ///
+    void s_getBitmapBlock(const uint8_t * bitmap, uint16_t bytesX, uint16_t sizeY, uint16_t column, int32_t band, bool flagReverse, uint8_t columns[8]);
+
+    ///
+    /// @brief Write a byte with a raster operation, physical coordinates
+    /// @param target byte of the frame-buffer
+    /// @param source byte of the bitmap, 1 = black
+    /// @param edge mask of the bits to write
+    /// @param operation raster operation, as per drawBitmap()
+    ///
+    inline void s_writeRaster(uint8_t * target, uint8_t source, uint8_t edge, uint8_t operation)
+    {
+        uint8_t invert = (u_invert) ? 0xff : 0x00;
+        uint8_t value = *target ^ invert; // 1 = black
+
+        switch (operation)
+        {
+            case BITMAP_OR:
+
+                value |= source;
+                break;
+
+            case BITMAP_AND:
+
+                value &= source;
+                break;
+
+            case BITMAP_XOR:
+
+                value ^= source;
+                break;
+
+            case BITMAP_NOT:
+
+                value = ~source;
+                break;
+
+            default: // BITMAP_COPY
+
+                value = source;
+                break;
+        }
+
+        *target = (*target & ~edge) | ((value ^ invert) & edge);
+    }
+
+    ///
+    /// @brief Expand a physical line of a character
+    /// @param line line, bit 31 = first point
+    /// @param length points in the line, up to 24
+    /// @param scale integer scale, 2..8
+    /// @param[out] data bytes, first point = MSB of first byte, up to 24 bytes
+    /// @return number of bytes
+    /// @note Scales 2, 4 and 8 use the doubling table, 3 and 6 the tripling table,
+    /// 5 and 7 expand point per point
+    ///
+    uint8_t s_scaleLine(uint32_t line, uint8_t length, uint8_t scale, uint8_t * data);
+
+    ///
+    /// @brief Physical lines of a character, for the current orientation
+    /// @param character character index, 0 = space
+    /// @param[out] lines one word per line, bit 31 = first point along H
+    /// @note Columns for orientations 1 and 3, rows for orientations 0 and 2
+    ///
+    void s_getCharacterLines(uint8_t character, uint32_t lines[24]);
+
+#if (GLYPH_CACHE_SIZE > 0)
+
+    ///
+    /// @brief Physical lines of a character, from the glyph cache
+    /// @param character character index, 0 = space
+    /// @param number number of lines
+    /// @param length points per line
+    /// @param[out] lines one word per line, bit 31 = first point along H
+    /// @note Characters beyond the size of the cache call s_getCharacterLines()
+    ///
+    void s_getCachedLines(uint8_t character, uint8_t number, uint8_t length, uint32_t lines[24]);
+
+    ///
+    /// @brief Glyph cache, rotated characters of one font for one orientation
+    /// @details Lines of each character stored as bytes in physical order,
+    /// built character per character on first use
+    /// @n Allocated on first use with GLYPH_CACHE_SIZE bytes,
+    /// dropped when the font or the orientation changes
+    ///
+    uint8_t * s_glyphCache;
+    uint8_t s_glyphFlags[28]; // one bit per character built, 224 characters
+    uint8_t s_glyphFont, s_glyphOrientation; // 0xff = none
+    uint16_t s_glyphBytes; // bytes per character
+    uint16_t s_glyphNumber; // characters held
+
+#endif // GLYPH_CACHE_SIZE
+
     /// @brief Get point
     /// @param x1 x coordinate
     /// @param y1 y coordinate
@@ -231,6 +754,57 @@ class Screen_EPD_EXT3_Fast final : public hV_Screen_Buffer, public hV_Utilities_
     ///
     void s_flush(uint8_t updateMode = UPDATE_FAST);
 
+    ///
+    /// @brief Window of flushRegion(), physical coordinates
+    /// @n s_windowLine1 > s_windowLine2 = full screen
+    ///
+    uint16_t s_windowLine1, s_windowLine2; // lines, along V
+    uint16_t s_windowByte1, s_windowByte2; // bytes, along H
+
+    ///
+    /// @brief Start the update, resume and send the image data
+    /// @param updateMode update mode
+    /// @note The update and the power off are performed step by step by s_flushNext()
+    ///
+    void s_flushBegin(uint8_t updateMode);
+
+    ///
+    /// @brief Perform the next step of the update or power off
+    /// @note The step sets the wait before the next one with s_waitFlush() or s_waitFlushBusy()
+    ///
+    void s_flushNext();
+
+    ///
+    /// @brief Record the statistics, suspend and call the callback
+    ///
+    void s_flushEnd();
+
+    ///
+    /// @brief Complete the update in progress, blocking
+    ///
+    void s_flushComplete();
+
+    ///
+    /// @brief Wait before the next step
+    /// @param us duration in us, multiple of 1000 for ms
+    ///
+    void s_waitFlush(uint32_t us);
+
+    ///
+    /// @brief Wait for busy before the next step
+    /// @param level ready level, default = HIGH
+    ///
+    void s_waitFlushBusy(uint8_t level = HIGH);
+
+    uint8_t s_flushPhase; // PHASE_UPDATE, PHASE_POWER_OFF, PHASE_FLUSH = done
+    uint8_t s_flushMode; // update mode
+    uint8_t s_flushStep; // step in current phase
+    uint8_t s_flushStage, s_flushRepeat, s_flushHalf; // DC/DC soft-start
+    uint8_t s_flushBusy; // ready level to wait for, FLUSH_BUSY_NONE = none
+    uint32_t s_flushDelay; // us
+    uint32_t s_flushChrono, s_flushChronoFlush, s_flushChronoWait; // us
+    void (*s_flushCallback)();
+
     // Position
     ///
     /// @brief Convert
@@ -248,6 +822,26 @@ class Screen_EPD_EXT3_Fast final : public hV_Screen_Buffer, public hV_Utilities_
     ///
     uint16_t s_getB(uint16_t x1, uint16_t y1);
 
+    uint32_t s_countSetPoint; // Statistics
+    statistics_t s_statisticsFlush[PHASE_NUMBER];
+
+    ///
+    /// @brief Record the duration of a phase of flush
+    /// @param phase phase
+    /// @param chrono start of the phase in us, updated to now
+    ///
+    void s_recordPhase(uint8_t phase, uint32_t & chrono);
+
+    uint32_t s_profileBegin[STAGE_NUMBER];
+    bool s_flagProfile; // true during begin()
+
+    ///
+    /// @brief Record the duration of a stage of begin()
+    /// @param stage stage
+    /// @param chrono start of the stage in us, updated to now
+    ///
+    void s_recordStage(uint8_t stage, uint32_t & chrono);
+
     //
     // === Energy section
     //
@@ -263,15 +857,19 @@ class Screen_EPD_EXT3_Fast final : public hV_Screen_Buffer, public hV_Utilities_
     void COG_MediumKP_getDataOTP();
     void COG_MediumKP_initial(uint8_t updateMode);
     void COG_MediumKP_sendImageData(uint8_t updateMode);
-    void COG_MediumKP_update(uint8_t updateMode);
-    void COG_MediumKP_powerOff();
+    void COG_MediumKP_sendImageWindow(uint8_t updateMode);
+    uint8_t COG_MediumKP_getIndexTemperature(uint8_t updateMode);
+    bool COG_MediumKP_update(uint8_t updateMode); // one step, true when done
+    bool COG_MediumKP_softStart(); // one step, true when done
+    uint32_t COG_MediumKP_getDelay(uint8_t delayOTP);
+    bool COG_MediumKP_powerOff(); // one step, true when done
 
     void COG_SmallKP_reset();
     void COG_SmallKP_getDataOTP();
     void COG_SmallKP_initial(uint8_t updateMode);
     void COG_SmallKP_sendImageData(uint8_t updateMode);
-    void COG_SmallKP_update(uint8_t updateMode);
-    void COG_SmallKP_powerOff();
+    bool COG_SmallKP_update(uint8_t updateMode); // one step, true when done
+    bool COG_SmallKP_powerOff(); // one step, true when done
 
     bool s_flag50; // Register 0x50
 
@@ -15,6 +15,10 @@
 // Release 801: Improved double-panel screen management
 // Release 804: Improved power management
 // Release 810: Added support for EXT4
+// Release 820: Added time in b_waitBusy()
+// Release 820: Added SPI counters
+// Release 820: Added trace points
+// Release 820: Added window of data
 //
 
 // Library header
@@ -31,6 +35,11 @@ void hV_Board::b_begin(pins_t board, uint8_t family, uint16_t delayCS)
     b_family = family;
     b_delayCS = delayCS;
     b_fsmPowerScreen = FSM_OFF;
+
+    b_levelCS = 0xff; // Unknown
+    b_levelCSS = 0xff;
+    b_levelDC = 0xff;
+    resetBoardCounters();
 }
 
 void hV_Board::setPanelPowerPin(uint8_t panelPowerPin)
@@ -47,17 +56,22 @@ void hV_Board::b_reset(uint32_t ms1, uint32_t ms2, uint32_t ms3, uint32_t ms4, u
     delay(ms3);
     digitalWrite(b_pin.panelReset, HIGH); // RESET = HIGH
     delay(ms4);
-    digitalWrite(b_pin.panelCS, HIGH); // CS = HIGH, unselect
+    b_writeCS(b_pin.panelCS, HIGH); // CS = HIGH, unselect
     delay(ms5);
 }
 
 void hV_Board::b_waitBusy(bool state)
 {
+    uint32_t chrono = micros();
+
     // LOW = busy, HIGH = ready
     while (digitalRead(b_pin.panelBusy) != state)
     {
         delay(32); // non-blocking
     }
+
+    b_timeBusy += micros() - chrono;
+    hV_HAL_TRACE(TRACE_WAIT_BUSY, micros() - chrono);
 }
 
 void hV_Board::b_suspend()
@@ -92,18 +106,18 @@ void hV_Board::b_resume()
         pinMode(b_pin.panelBusy, INPUT);
 
         pinMode(b_pin.panelDC, OUTPUT);
-        digitalWrite(b_pin.panelDC, HIGH);
+        b_writeDC(HIGH);
 
         pinMode(b_pin.panelReset, OUTPUT);
         digitalWrite(b_pin.panelReset, HIGH);
 
         pinMode(b_pin.panelCS, OUTPUT);
-        digitalWrite(b_pin.panelCS, HIGH); // CS# = 1
+        b_writeCS(b_pin.panelCS, HIGH); // CS# = 1
 
         if (b_pin.panelCSS != NOT_CONNECTED) // generic
         {
             pinMode(b_pin.panelCSS, OUTPUT);
-            digitalWrite(b_pin.panelCSS, HIGH);
+            b_writeCS(b_pin.panelCSS, HIGH);
         }
 
         // External SPI memory
@@ -169,125 +183,163 @@ void hV_Board::b_resume()
 
 void hV_Board::b_sendIndexFixed(uint8_t index, uint8_t data, uint32_t size)
 {
-    digitalWrite(b_pin.panelDC, LOW); // DC Low = Command
-    digitalWrite(b_pin.panelCS, LOW); // CS High = Select Master
+    b_writeDC(LOW); // DC Low = Command
+    b_writeCS(b_pin.panelCS, LOW); // CS High = Select Master
 
-    delayMicroseconds(b_delayCS);
+    b_waitCS();
     hV_HAL_SPI_transfer(index);
-    delayMicroseconds(b_delayCS);
+    b_counters.commandBytes += 1;
+    b_waitCS();
 
-    digitalWrite(b_pin.panelDC, HIGH); // DC High = Data
+    b_writeDC(HIGH); // DC High = Data
 
-    delayMicroseconds(b_delayCS);
+    b_waitCS();
     for (uint32_t i = 0; i < size; i++)
     {
         hV_HAL_SPI_transfer(data); // b_sendIndexFixed
     }
-    delayMicroseconds(b_delayCS);
+    b_counters.dataBytes += size;
+    b_waitCS();
 
-    digitalWrite(b_pin.panelCS, HIGH); // CS High = Unselect
+    b_writeCS(b_pin.panelCS, HIGH); // CS High = Unselect
 }
 
 void hV_Board::b_sendIndexFixedSelect(uint8_t index, uint8_t data, uint32_t size, uint8_t select)
 {
-    digitalWrite(b_pin.panelDC, LOW); // DC Low = Command
+    b_writeDC(LOW); // DC Low = Command
     b_select(select); // Select half of large screen
 
-    delayMicroseconds(b_delayCS); // Longer delay for large screens
+    b_waitCS(); // Longer delay for large screens
     hV_HAL_SPI_transfer(index);
-    delayMicroseconds(b_delayCS); // Longer delay for large screens
+    b_counters.commandBytes += 1;
+    b_waitCS(); // Longer delay for large screens
 
-    digitalWrite(b_pin.panelDC, HIGH); // DC High = Data
+    b_writeDC(HIGH); // DC High = Data
 
-    delayMicroseconds(b_delayCS); // Longer delay for large screens
+    b_waitCS(); // Longer delay for large screens
     for (uint32_t i = 0; i < size; i++)
     {
         hV_HAL_SPI_transfer(data); // b_sendIndexFixed
     }
-    delayMicroseconds(b_delayCS); // Longer delay for large screens
+    b_counters.dataBytes += size;
+    b_waitCS(); // Longer delay for large screens
 
-    digitalWrite(b_pin.panelCS, HIGH); // CS High = Unselect Master
+    b_writeCS(b_pin.panelCS, HIGH); // CS High = Unselect Master
     if (b_pin.panelCSS != NOT_CONNECTED)
     {
-        digitalWrite(b_pin.panelCSS, HIGH); // CSS High = Unselect Slave
+        b_writeCS(b_pin.panelCSS, HIGH); // CSS High = Unselect Slave
     }
 }
 
 void hV_Board::b_sendIndexData(uint8_t index, const uint8_t * data, uint32_t size)
 {
-    digitalWrite(b_pin.panelDC, LOW); // DC Low
-    digitalWrite(b_pin.panelCS, LOW); // CS Low
+    hV_HAL_TRACE(TRACE_SEND_INDEX, ((uint32_t)index << 24) | (size & 0x00ffffff));
+    b_writeDC(LOW); // DC Low
+    b_writeCS(b_pin.panelCS, LOW); // CS Low
     if (b_family == FAMILY_LARGE)
     {
         if (b_pin.panelCSS != NOT_CONNECTED)
         {
-            digitalWrite(b_pin.panelCSS, LOW);
+            b_writeCS(b_pin.panelCSS, LOW);
         }
-        delayMicroseconds(450); // 450 + 50 = 500
+        b_waitCSS(); // 450 + 50 = 500
     }
-    delayMicroseconds(b_delayCS);
+    b_waitCS();
     hV_HAL_SPI_transfer(index);
-    delayMicroseconds(b_delayCS);
+    b_counters.commandBytes += 1;
+    b_waitCS();
     if (b_family == FAMILY_LARGE)
     {
         if (b_pin.panelCSS != NOT_CONNECTED)
         {
-            delayMicroseconds(450); // 450 + 50 = 500
-            digitalWrite(b_pin.panelCSS, HIGH);
+            b_waitCSS(); // 450 + 50 = 500
+            b_writeCS(b_pin.panelCSS, HIGH);
         }
     }
-    digitalWrite(b_pin.panelCS, HIGH); // CS High
-    digitalWrite(b_pin.panelDC, HIGH); // DC High
-    digitalWrite(b_pin.panelCS, LOW); // CS Low
+    b_writeCS(b_pin.panelCS, HIGH); // CS High
+    b_writeDC(HIGH); // DC High
+    b_writeCS(b_pin.panelCS, LOW); // CS Low
     if (b_family == FAMILY_LARGE)
     {
         if (b_pin.panelCSS != NOT_CONNECTED)
         {
-            digitalWrite(b_pin.panelCSS, LOW); // CSS Low
-            delayMicroseconds(450); // 450 + 50 = 500
+            b_writeCS(b_pin.panelCSS, LOW); // CSS Low
+            b_waitCSS(); // 450 + 50 = 500
         }
     }
-    delayMicroseconds(b_delayCS);
+    b_waitCS();
     for (uint32_t i = 0; i < size; i++)
     {
         hV_HAL_SPI_transfer(data[i]);
     }
-    delayMicroseconds(b_delayCS);
-    digitalWrite(b_pin.panelCS, HIGH); // CS High
+    b_counters.dataBytes += size;
+    b_waitCS();
+    b_writeCS(b_pin.panelCS, HIGH); // CS High
     if (b_family == FAMILY_LARGE)
     {
         if (b_pin.panelCSS != NOT_CONNECTED)
         {
-            delayMicroseconds(450); // 450 + 50 = 500
-            digitalWrite(b_pin.panelCSS, HIGH);
+            b_waitCSS(); // 450 + 50 = 500
+            b_writeCS(b_pin.panelCSS, HIGH);
         }
     }
-    delayMicroseconds(b_delayCS);
+    b_waitCS();
+}
+
+void hV_Board::b_sendIndexDataWindow(uint8_t index, const uint8_t * data, uint16_t size, uint16_t number, uint16_t stride)
+{
+    hV_HAL_TRACE(TRACE_SEND_INDEX, ((uint32_t)index << 24) | (((uint32_t)size * number) & 0x00ffffff));
+    b_writeDC(LOW); // DC Low = Command
+    b_writeCS(b_pin.panelCS, LOW); // CS Low = Select
+
+    b_waitCS();
+    hV_HAL_SPI_transfer(index);
+    b_counters.commandBytes += 1;
+    b_waitCS();
+
+    b_writeDC(HIGH); // DC High = Data
+
+    b_waitCS();
+    for (uint16_t line = 0; line < number; line += 1)
+    {
+        for (uint16_t i = 0; i < size; i++)
+        {
+            hV_HAL_SPI_transfer(data[i]);
+        }
+        data += stride;
+    }
+    b_counters.dataBytes += (uint32_t)size * number;
+    b_waitCS();
+
+    b_writeCS(b_pin.panelCS, HIGH); // CS High = Unselect
 }
 
 // Software SPI Master protocol setup
 void hV_Board::b_sendIndexDataSelect(uint8_t index, const uint8_t * data, uint32_t size, uint8_t select)
 {
-    digitalWrite(b_pin.panelDC, LOW); // DC Low = Command
+    hV_HAL_TRACE(TRACE_SEND_INDEX, ((uint32_t)index << 24) | (size & 0x00ffffff));
+    b_writeDC(LOW); // DC Low = Command
     b_select(select); // Select half of large screen
 
-    delayMicroseconds(b_delayCS); // Longer delay for large screens
+    b_waitCS(); // Longer delay for large screens
     hV_HAL_SPI_transfer(index);
-    delayMicroseconds(b_delayCS); // Longer delay for large screens
+    b_counters.commandBytes += 1;
+    b_waitCS(); // Longer delay for large screens
 
-    digitalWrite(b_pin.panelDC, HIGH); // DC High = Data
+    b_writeDC(HIGH); // DC High = Data
 
-    delayMicroseconds(b_delayCS); // Longer delay for large screens
+    b_waitCS(); // Longer delay for large screens
     for (uint32_t i = 0; i < size; i++)
     {
         hV_HAL_SPI_transfer(data[i]);
     }
-    delayMicroseconds(b_delayCS); // Longer delay for large screens
+    b_counters.dataBytes += size;
+    b_waitCS(); // Longer delay for large screens
 
-    digitalWrite(b_pin.panelCS, HIGH); // CS high = Unselect Master
+    b_writeCS(b_pin.panelCS, HIGH); // CS high = Unselect Master
     if (b_pin.panelCSS != NOT_CONNECTED)
     {
-        digitalWrite(b_pin.panelCSS, HIGH); // CSS High = Unselect Slave
+        b_writeCS(b_pin.panelCSS, HIGH); // CSS High = Unselect Slave
     }
 }
 
@@ -297,79 +349,135 @@ void hV_Board::b_select(uint8_t select)
     {
         case PANEL_CS_MASTER:
 
-            digitalWrite(b_pin.panelCS, LOW); // CS Low = Select Master
+            b_writeCS(b_pin.panelCS, LOW); // CS Low = Select Master
             if (b_pin.panelCSS != NOT_CONNECTED)
             {
-                digitalWrite(b_pin.panelCSS, HIGH); // CSS High = Unselect Slave
+                b_writeCS(b_pin.panelCSS, HIGH); // CSS High = Unselect Slave
             }
             break;
 
         case PANEL_CS_SLAVE:
 
-            digitalWrite(b_pin.panelCS, HIGH); // CS high = Unselect Master
+            b_writeCS(b_pin.panelCS, HIGH); // CS high = Unselect Master
             if (b_pin.panelCSS != NOT_CONNECTED)
             {
-                digitalWrite(b_pin.panelCSS, LOW); // CSS Low = Select Slave
+                b_writeCS(b_pin.panelCSS, LOW); // CSS Low = Select Slave
             }
             break;
 
         default:
 
-            digitalWrite(b_pin.panelCS, LOW); // CS Low = Select Master
+            b_writeCS(b_pin.panelCS, LOW); // CS Low = Select Master
             if (b_pin.panelCSS != NOT_CONNECTED)
             {
-                digitalWrite(b_pin.panelCSS, LOW); // CSS Low = Select Slave
+                b_writeCS(b_pin.panelCSS, LOW); // CSS Low = Select Slave
             }
             break;
     }
 
     if (b_pin.panelCSS != NOT_CONNECTED)
     {
-        delayMicroseconds(450); // 450 + 50 = 500
+        b_waitCSS(); // 450 + 50 = 500
     }
-    delayMicroseconds(b_delayCS); // Longer delay for large screens
+    b_waitCS(); // Longer delay for large screens
 }
 
 void hV_Board::b_sendCommandDataSelect8(uint8_t command, uint8_t data, uint8_t select)
 {
-    digitalWrite(b_pin.panelDC, LOW); // LOW = command
+    b_writeDC(LOW); // LOW = command
     b_select(select); // Select half of large screen
 
     hV_HAL_SPI_transfer(command);
+    b_counters.commandBytes += 1;
 
-    digitalWrite(b_pin.panelDC, HIGH); // HIGH = data
+    b_writeDC(HIGH); // HIGH = data
     hV_HAL_SPI_transfer(data);
+    b_counters.dataBytes += 1;
 
-    digitalWrite(b_pin.panelCS, HIGH);
+    b_writeCS(b_pin.panelCS, HIGH);
     if (b_pin.panelCSS != NOT_CONNECTED)
     {
-        digitalWrite(b_pin.panelCSS, HIGH);
+        b_writeCS(b_pin.panelCSS, HIGH);
     }
 }
 
 void hV_Board::b_sendCommand8(uint8_t command)
 {
-    digitalWrite(b_pin.panelDC, LOW);
-    digitalWrite(b_pin.panelCS, LOW);
+    b_writeDC(LOW);
+    b_writeCS(b_pin.panelCS, LOW);
 
     hV_HAL_SPI_transfer(command);
+    b_counters.commandBytes += 1;
 
-    digitalWrite(b_pin.panelCS, HIGH);
+    b_writeCS(b_pin.panelCS, HIGH);
 }
 
 void hV_Board::b_sendCommandData8(uint8_t command, uint8_t data)
 {
-    digitalWrite(b_pin.panelDC, LOW); // LOW = command
-    digitalWrite(b_pin.panelCS, LOW);
+    b_writeDC(LOW); // LOW = command
+    b_writeCS(b_pin.panelCS, LOW);
 
     hV_HAL_SPI_transfer(command);
+    b_counters.commandBytes += 1;
 
-    digitalWrite(b_pin.panelDC, HIGH); // HIGH = data
+    b_writeDC(HIGH); // HIGH = data
     hV_HAL_SPI_transfer(data);
+    b_counters.dataBytes += 1;
 
-    digitalWrite(b_pin.panelCS, HIGH);
+    b_writeCS(b_pin.panelCS, HIGH);
 }
 
+//
+// === Counters section
+//
+void hV_Board::b_writeCS(uint8_t pin, uint8_t level)
+{
+    digitalWrite(pin, level);
+
+    uint8_t & last = (pin == b_pin.panelCS) ? b_levelCS : b_levelCSS;
+    if (last != level)
+    {
+        b_counters.transitionsCS += 1;
+        last = level;
+    }
+}
+
+void hV_Board::b_writeDC(uint8_t level)
+{
+    digitalWrite(b_pin.panelDC, level);
+
+    if (b_levelDC != level)
+    {
+        b_counters.transitionsDC += 1;
+        b_levelDC = level;
+    }
+}
+
+void hV_Board::b_waitCS()
+{
+    delayMicroseconds(b_delayCS);
+    b_counters.timeDelayCS += b_delayCS;
+}
+
+void hV_Board::b_waitCSS()
+{
+    delayMicroseconds(450); // 450 + 50 = 500
+    b_counters.timeGuardCSS += 450;
+}
+
+counters_t hV_Board::getBoardCounters()
+{
+    return b_counters;
+}
+
+void hV_Board::resetBoardCounters()
+{
+    memset(&b_counters, 0x00, sizeof(b_counters));
+}
+//
+// === End of Counters section
+//
+
 //
 // === Miscellaneous section
 //
@@ -46,6 +46,20 @@
 ///
 #define hV_BOARD_RELEASE 812
 
+///
+/// @brief SPI counters
+/// @note Counters cover the functions of hV_Board
+///
+struct counters_t
+{
+    uint32_t commandBytes; ///< command bytes sent, DC low
+    uint32_t dataBytes; ///< data bytes sent, DC high
+    uint32_t transitionsCS; ///< transitions of CS and CSS
+    uint32_t transitionsDC; ///< transitions of DC
+    uint32_t timeDelayCS; ///< us spent in delays for CS, b_delayCS
+    uint32_t timeGuardCSS; ///< us spent in 450 us guards for CSS
+};
+
 // Objects
 //
 ///
@@ -77,6 +91,18 @@ class hV_Board
     ///
     pins_t getBoardPins();
 
+    ///
+    /// @brief Get the SPI counters
+    /// @return counters since last reset
+    /// @note Counters are reset at the start of each flush
+    ///
+    counters_t getBoardCounters();
+
+    ///
+    /// @brief Reset the SPI counters
+    ///
+    void resetBoardCounters();
+
     /// @cond
   protected:
 
@@ -130,6 +156,18 @@ class hV_Board
     ///
     void b_sendIndexData(uint8_t index, const uint8_t * data, uint32_t size);
 
+    ///
+    /// @brief Send window of data through SPI
+    /// @param index register
+    /// @param data data, first byte of the window
+    /// @param size number of bytes per line
+    /// @param number number of lines
+    /// @param stride bytes between two consecutive lines
+    /// @note Lines are sent as one stream after the index
+    /// @note Valid for all except large screens
+    ///
+    void b_sendIndexDataWindow(uint8_t index, const uint8_t * data, uint16_t size, uint16_t number, uint16_t stride);
+
     ///
     /// @brief Send data through SPI to selected half of large screen
     /// @param index register
@@ -184,7 +222,35 @@ class hV_Board
     ///
     void b_resume();
 
+    ///
+    /// @brief Set CS or CSS and count transitions
+    /// @param pin panelCS or panelCSS
+    /// @param level level
+    ///
+    void b_writeCS(uint8_t pin, uint8_t level);
+
+    ///
+    /// @brief Set DC and count transitions
+    /// @param level level
+    ///
+    void b_writeDC(uint8_t level);
+
+    ///
+    /// @brief Delay for CS and count time
+    /// @note Delay is b_delayCS, in us
+    ///
+    void b_waitCS();
+
+    ///
+    /// @brief Guard for CSS and count time
+    /// @note Guard is 450 us
+    ///
+    void b_waitCSS();
+
     pins_t b_pin;
+    counters_t b_counters;
+    uint8_t b_levelCS, b_levelCSS, b_levelDC; // Last levels, 0xff = unknown
+    uint32_t b_timeBusy = 0; // us, cumulated in b_waitBusy()
     uint16_t b_delayCS = 50; // ms
     uint8_t b_family;
     uint8_t b_fsmPowerScreen = FSM_OFF;
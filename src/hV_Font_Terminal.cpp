@@ -20,6 +20,7 @@
 // All rights reserved
 //
 // Release 803: Added types for string and frame-buffer
+// Release 820: Added size of font tables
 //
 
 // Configuration
@@ -137,6 +138,26 @@ uint8_t hV_Font_Terminal::f_getCharacter(uint8_t character, uint16_t index)
 #endif // end MAX_FONT_SIZE > 0
 }
 
+uint32_t hV_Font_Terminal::f_sizeFontTables()
+{
+    uint32_t result = 0;
+
+#if (MAX_FONT_SIZE > 0)
+    result += sizeof(Terminal6x8e);
+#if (MAX_FONT_SIZE > 1)
+    result += sizeof(Terminal8x12e);
+#if (MAX_FONT_SIZE > 2)
+    result += sizeof(Terminal12x16e);
+#if (MAX_FONT_SIZE > 3)
+    result += sizeof(Terminal16x24e);
+#endif // end MAX_FONT_SIZE > 3
+#endif // end MAX_FONT_SIZE > 2
+#endif // end MAX_FONT_SIZE > 1
+#endif // end MAX_FONT_SIZE > 0
+
+    return result;
+}
+
 uint16_t hV_Font_Terminal::f_characterSizeX(uint8_t character)
 {
     return f_font.maxWidth;
@@ -211,6 +211,12 @@ class hV_Font_Terminal
     ///
     uint8_t f_getCharacter(uint8_t character, uint16_t index);
 
+    ///
+    /// @brief Size of the font tables
+    /// @return size in bytes of the font tables included with MAX_FONT_SIZE
+    ///
+    uint32_t f_sizeFontTables();
+
     ///
     /// @name Variables for font management
     /// @{
@@ -0,0 +1,860 @@
+//
+// hV_HAL_Host.cpp
+// C++ code
+// ----------------------------------
+//
+// Project highView Library Suite
+//
+// Created by Rei Vilo, 21 Feb 2025
+//
+// Copyright (c) Rei Vilo, 2010-2025
+// Licence All rights reserved
+//
+// * Basic edition: for hobbyists and for basic usage
+// Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+//
+// * Evaluation edition: for professionals or organisations, evaluation only, no commercial usage
+// All rights reserved
+//
+// * Commercial edition: for professionals or organisations, commercial usage
+// All rights reserved
+//
+// Release 820: Added host back-end
+// Release 820: Added image export and import
+//
+
+// The Arduino IDE does not allow to select the files, hence this condition.
+#if defined(hV_HAL_HOST)
+
+// Library header
+#include "hV_HAL_Host.h"
+
+// Standard libraries
+#include <ctype.h>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+//
+// === Time section
+//
+static uint8_t h_clockMode = HOST_CLOCK_HYBRID;
+static uint64_t h_simulatedTime = 0; // ns
+static uint64_t h_hostStart = 0; // ns
+
+static uint64_t h_hostTime()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+void hV_HAL_Host_setClock(uint8_t mode)
+{
+    h_clockMode = mode;
+}
+
+void hV_HAL_Host_addTime(uint64_t ns)
+{
+    h_simulatedTime += ns;
+}
+
+uint64_t hV_HAL_Host_getTime()
+{
+    uint64_t result = h_simulatedTime;
+
+    if (h_clockMode == HOST_CLOCK_HYBRID)
+    {
+        if (h_hostStart == 0)
+        {
+            h_hostStart = h_hostTime();
+        }
+        result += h_hostTime() - h_hostStart;
+    }
+
+    return result;
+}
+
+uint32_t micros()
+{
+    return (uint32_t)(hV_HAL_Host_getTime() / 1000ULL);
+}
+
+uint32_t millis()
+{
+    return (uint32_t)(hV_HAL_Host_getTime() / 1000000ULL);
+}
+//
+// === End of Time section
+//
+
+//
+// === Recorder section
+//
+static bool h_flagRecord = false;
+static std::vector<hV_HAL_Host_event_t> h_events;
+
+static void h_record(uint8_t kind, uint8_t pin, uint32_t value)
+{
+    if (h_flagRecord)
+    {
+        hV_HAL_Host_event_t event = { micros(), kind, pin, value };
+        h_events.push_back(event);
+    }
+}
+
+void hV_HAL_Host_record(bool flag)
+{
+    h_flagRecord = flag;
+}
+
+uint32_t hV_HAL_Host_getEventsCount()
+{
+    return (uint32_t)h_events.size();
+}
+
+const hV_HAL_Host_event_t * hV_HAL_Host_getEvents()
+{
+    return h_events.data();
+}
+
+void hV_HAL_Host_clearEvents()
+{
+    h_events.clear();
+}
+
+void hV_HAL_Host_dumpEvents(FILE * file)
+{
+    fprintf(file, "time,kind,pin,value\n");
+    for (const hV_HAL_Host_event_t & event : h_events)
+    {
+        fprintf(file, "%u,0x%02x,%u,0x%x\n", event.time, event.kind, event.pin, event.value);
+    }
+}
+//
+// === End of Recorder section
+//
+
+//
+// === Devices section
+//
+#define HOST_DEVICES_MAX 4
+
+static hV_HAL_Host_Device * h_devices[HOST_DEVICES_MAX] = { 0 };
+
+void hV_HAL_Host_attach(hV_HAL_Host_Device * device)
+{
+    for (uint8_t index = 0; index < HOST_DEVICES_MAX; index += 1)
+    {
+        if ((h_devices[index] == 0) or (h_devices[index] == device))
+        {
+            h_devices[index] = device;
+            return;
+        }
+    }
+    fprintf(stderr, "hV * Host: no slot left for device\n");
+}
+
+void hV_HAL_Host_detach(hV_HAL_Host_Device * device)
+{
+    for (uint8_t index = 0; index < HOST_DEVICES_MAX; index += 1)
+    {
+        if (h_devices[index] == device)
+        {
+            h_devices[index] = 0;
+        }
+    }
+}
+//
+// === End of Devices section
+//
+
+//
+// === GPIO section
+//
+static uint8_t h_pinLevel[256]; // Undriven pins read HIGH, see h_beginPins()
+static uint8_t h_pinMode[256] = { 0 };
+
+static bool h_beginPins()
+{
+    memset(h_pinLevel, HIGH, sizeof(h_pinLevel));
+    return true;
+}
+
+static bool h_flagPins = h_beginPins();
+
+void hV_HAL_Host_setPin(uint8_t pin, uint8_t level)
+{
+    h_pinLevel[pin] = level;
+}
+
+uint8_t hV_HAL_Host_getPin(uint8_t pin)
+{
+    return h_pinLevel[pin];
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    h_pinMode[pin] = mode;
+    if (mode == INPUT_PULLUP)
+    {
+        h_pinLevel[pin] = HIGH;
+    }
+    h_record(HOST_EVENT_PIN_MODE, pin, mode);
+}
+
+void digitalWrite(uint8_t pin, uint8_t level)
+{
+    level = (level != LOW) ? HIGH : LOW;
+    h_pinLevel[pin] = level;
+    h_record(HOST_EVENT_PIN_WRITE, pin, level);
+
+    for (hV_HAL_Host_Device * device : h_devices)
+    {
+        if (device != 0)
+        {
+            device->onPinWrite(pin, level);
+        }
+    }
+}
+
+int digitalRead(uint8_t pin)
+{
+    uint8_t level = h_pinLevel[pin];
+
+    for (hV_HAL_Host_Device * device : h_devices)
+    {
+        if (device != 0)
+        {
+            device->onPinRead(pin, level);
+        }
+    }
+
+    h_record(HOST_EVENT_PIN_READ, pin, level);
+    return level;
+}
+
+int analogRead(uint8_t /* pin */)
+{
+    return 0;
+}
+
+void delay(uint32_t ms)
+{
+    h_record(HOST_EVENT_DELAY, 0, ms * 1000);
+    hV_HAL_Host_addTime((uint64_t)ms * 1000000ULL);
+}
+
+void delayMicroseconds(uint32_t us)
+{
+    if (us > 0)
+    {
+        h_record(HOST_EVENT_DELAY, 0, us);
+        hV_HAL_Host_addTime((uint64_t)us * 1000ULL);
+    }
+}
+
+void yield()
+{
+    ;
+}
+
+long map(long value, long fromLow, long fromHigh, long toLow, long toHigh)
+{
+    return (value - fromLow) * (toHigh - toLow) / (fromHigh - fromLow) + toLow;
+}
+
+static uint32_t h_randomState = 1;
+
+long random(long howBig)
+{
+    if (howBig == 0)
+    {
+        return 0;
+    }
+    h_randomState = h_randomState * 1103515245UL + 12345UL; // Deterministic
+    return (long)((h_randomState >> 16) % (uint32_t)howBig);
+}
+
+long random(long howSmall, long howBig)
+{
+    if (howSmall >= howBig)
+    {
+        return howSmall;
+    }
+    return howSmall + random(howBig - howSmall);
+}
+
+void randomSeed(unsigned long seed)
+{
+    h_randomState = (seed == 0) ? 1 : seed;
+}
+//
+// === End of GPIO section
+//
+
+//
+// === Bus section
+//
+static uint32_t h_speedSPI = 8000000;
+
+void hV_HAL_Host_SPI_begin(uint32_t speed)
+{
+    h_speedSPI = (speed > 0) ? speed : 8000000;
+}
+
+uint8_t hV_HAL_Host_SPI_transfer(uint8_t data)
+{
+    uint8_t result = 0x00;
+
+    for (hV_HAL_Host_Device * device : h_devices)
+    {
+        if (device != 0)
+        {
+            device->onSPI(data, result);
+        }
+    }
+
+    hV_HAL_Host_addTime(8000000000ULL / h_speedSPI);
+    h_record(HOST_EVENT_SPI, 0, (data << 8) | result);
+    return result;
+}
+
+void hV_HAL_Host_SPI3_write(uint8_t data)
+{
+    for (hV_HAL_Host_Device * device : h_devices)
+    {
+        if (device != 0)
+        {
+            device->onSPI3Write(data);
+        }
+    }
+
+    hV_HAL_Host_addTime(8 * 3000ULL); // 3 x 1 us per bit
+    h_record(HOST_EVENT_SPI3_WRITE, 0, data);
+}
+
+uint8_t hV_HAL_Host_SPI3_read()
+{
+    uint8_t result = 0x00;
+
+    for (hV_HAL_Host_Device * device : h_devices)
+    {
+        if (device != 0)
+        {
+            device->onSPI3Read(result);
+        }
+    }
+
+    hV_HAL_Host_addTime(8 * 2000ULL); // 2 x 1 us per bit
+    h_record(HOST_EVENT_SPI3_READ, 0, result);
+    return result;
+}
+
+void hV_HAL_Host_Wire_transfer(uint8_t address, uint8_t * dataWrite, size_t sizeWrite, uint8_t * dataRead, size_t sizeRead)
+{
+    if (sizeRead > 0)
+    {
+        memset(dataRead, 0x00, sizeRead);
+    }
+
+    for (hV_HAL_Host_Device * device : h_devices)
+    {
+        if (device != 0)
+        {
+            if (device->onWire(address, dataWrite, sizeWrite, dataRead, sizeRead))
+            {
+                break;
+            }
+        }
+    }
+
+    // 400 kHz, 9 bits per byte, plus address byte for each direction
+    size_t bytes = sizeWrite + sizeRead + ((sizeWrite > 0) ? 1 : 0) + ((sizeRead > 0) ? 1 : 0);
+    hV_HAL_Host_addTime((uint64_t)bytes * 22500ULL);
+
+    for (size_t index = 0; index < sizeWrite; index += 1)
+    {
+        h_record(HOST_EVENT_WIRE_WRITE, address, dataWrite[index]);
+    }
+    for (size_t index = 0; index < sizeRead; index += 1)
+    {
+        h_record(HOST_EVENT_WIRE_READ, address, dataRead[index]);
+    }
+}
+//
+// === End of Bus section
+//
+
+//
+// === String section
+//
+static std::string h_formatNumber(unsigned long value, uint8_t base)
+{
+    char buffer[8 * sizeof(unsigned long) + 1];
+    char * pointer = &buffer[sizeof(buffer) - 1];
+    *pointer = '\0';
+
+    if (base < 2)
+    {
+        base = 10;
+    }
+
+    do
+    {
+        uint8_t digit = value % base;
+        *--pointer = (digit < 10) ? ('0' + digit) : ('a' + digit - 10);
+        value /= base;
+    }
+    while (value > 0);
+
+    return std::string(pointer);
+}
+
+String::String(const char * text) : _text((text != 0) ? text : "") { }
+String::String(const std::string & text) : _text(text) { }
+String::String(char c) : _text(1, c) { }
+String::String(int value, uint8_t base) : String((long)value, base) { }
+String::String(unsigned int value, uint8_t base) : String((unsigned long)value, base) { }
+
+String::String(long value, uint8_t base)
+{
+    if ((value < 0) and (base == DEC))
+    {
+        _text = "-" + h_formatNumber((unsigned long)(-value), base);
+    }
+    else
+    {
+        _text = h_formatNumber((unsigned long)value, base);
+    }
+}
+
+String::String(unsigned long value, uint8_t base) : _text(h_formatNumber(value, base)) { }
+
+String::String(double value, uint8_t decimals)
+{
+    char buffer[48];
+    snprintf(buffer, sizeof(buffer), "%.*f", decimals, value);
+    _text = buffer;
+}
+
+unsigned int String::length() const
+{
+    return (unsigned int)_text.length();
+}
+
+char String::charAt(unsigned int index) const
+{
+    return (index < _text.length()) ? _text[index] : '\0';
+}
+
+const char * String::c_str() const
+{
+    return _text.c_str();
+}
+
+String String::substring(unsigned int beginIndex) const
+{
+    return substring(beginIndex, length());
+}
+
+String String::substring(unsigned int beginIndex, unsigned int endIndex) const
+{
+    if (beginIndex > endIndex)
+    {
+        std::swap(beginIndex, endIndex);
+    }
+    if (beginIndex >= _text.length())
+    {
+        return String("");
+    }
+    endIndex = std::min(endIndex, length());
+
+    return String(_text.substr(beginIndex, endIndex - beginIndex));
+}
+
+void String::toCharArray(char * buffer, unsigned int bufferSize) const
+{
+    if ((buffer == 0) or (bufferSize == 0))
+    {
+        return;
+    }
+
+    size_t size = std::min((size_t)bufferSize - 1, _text.length());
+    memcpy(buffer, _text.c_str(), size);
+    buffer[size] = '\0';
+}
+
+int String::indexOf(char c) const
+{
+    size_t result = _text.find(c);
+    return (result == std::string::npos) ? -1 : (int)result;
+}
+
+long String::toInt() const
+{
+    return atol(_text.c_str());
+}
+
+String & String::operator+=(const String & other)
+{
+    _text += other._text;
+    return *this;
+}
+
+char String::operator[](unsigned int index) const
+{
+    return charAt(index);
+}
+
+bool String::operator==(const String & other) const
+{
+    return (_text == other._text);
+}
+
+bool String::operator!=(const String & other) const
+{
+    return (_text != other._text);
+}
+
+String operator+(const String & left, const String & right)
+{
+    return String(left._text + right._text);
+}
+//
+// === End of String section
+//
+
+//
+// === Serial section
+//
+hV_HAL_Host_Serial Serial;
+
+void hV_HAL_Host_Serial::begin(uint32_t /* speed */)
+{
+    ;
+}
+
+void hV_HAL_Host_Serial::flush()
+{
+    fflush(stdout);
+}
+
+hV_HAL_Host_Serial::operator bool() const
+{
+    return true;
+}
+
+size_t hV_HAL_Host_Serial::print(const String & text)
+{
+    return fwrite(text.c_str(), 1, text.length(), stdout);
+}
+
+size_t hV_HAL_Host_Serial::print(const char * text)
+{
+    return fwrite(text, 1, strlen(text), stdout);
+}
+
+size_t hV_HAL_Host_Serial::print(char c)
+{
+    return fwrite(&c, 1, 1, stdout);
+}
+
+size_t hV_HAL_Host_Serial::print(unsigned char value, int base)
+{
+    return print(String((unsigned long)value, base));
+}
+
+size_t hV_HAL_Host_Serial::print(int value, int base)
+{
+    return print(String((long)value, base));
+}
+
+size_t hV_HAL_Host_Serial::print(unsigned int value, int base)
+{
+    return print(String((unsigned long)value, base));
+}
+
+size_t hV_HAL_Host_Serial::print(long value, int base)
+{
+    return print(String(value, base));
+}
+
+size_t hV_HAL_Host_Serial::print(unsigned long value, int base)
+{
+    return print(String(value, base));
+}
+
+size_t hV_HAL_Host_Serial::print(double value, int decimals)
+{
+    return print(String(value, decimals));
+}
+
+size_t hV_HAL_Host_Serial::println()
+{
+    return print("\r\n");
+}
+
+size_t hV_HAL_Host_Serial::printf(const char * format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int result = vprintf(format, args);
+    va_end(args);
+
+    return (result > 0) ? result : 0;
+}
+//
+// === End of Serial section
+//
+
+//
+// === Image section
+//
+static uint32_t h_crc32(uint32_t crc, const uint8_t * data, uint32_t size)
+{
+    crc = ~crc;
+    for (uint32_t index = 0; index < size; index += 1)
+    {
+        crc ^= data[index];
+        for (uint8_t bit = 0; bit < 8; bit += 1)
+        {
+            crc = (crc >> 1) ^ (0xedb88320 & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+static void h_appendBigEndian(std::vector<uint8_t> & buffer, uint32_t value)
+{
+    buffer.push_back(value >> 24);
+    buffer.push_back(value >> 16);
+    buffer.push_back(value >> 8);
+    buffer.push_back(value);
+}
+
+static void h_writeChunk(FILE * file, const char * type, const std::vector<uint8_t> & data)
+{
+    std::vector<uint8_t> chunk;
+    h_appendBigEndian(chunk, (uint32_t)data.size());
+    chunk.insert(chunk.end(), type, type + 4);
+    chunk.insert(chunk.end(), data.begin(), data.end());
+    h_appendBigEndian(chunk, h_crc32(0, chunk.data() + 4, (uint32_t)chunk.size() - 4));
+    fwrite(chunk.data(), 1, chunk.size(), file);
+}
+
+static void h_writePNG(FILE * file, const uint8_t * image, uint16_t sizeX, uint16_t sizeY)
+{
+    const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', 0x0d, 0x0a, 0x1a, 0x0a };
+    fwrite(signature, 1, sizeof(signature), file);
+
+    std::vector<uint8_t> header;
+    h_appendBigEndian(header, sizeX);
+    h_appendBigEndian(header, sizeY);
+    header.push_back(1); // bit depth
+    header.push_back(0); // grey
+    header.push_back(0); // deflate
+    header.push_back(0); // filter
+    header.push_back(0); // no interlace
+    h_writeChunk(file, "IHDR", header);
+
+    // Raw lines with filter type 0, PNG grey is 0 = black
+    uint16_t bytesX = (sizeX + 7) / 8;
+    std::vector<uint8_t> raw;
+    for (uint16_t y = 0; y < sizeY; y += 1)
+    {
+        raw.push_back(0);
+        for (uint16_t x = 0; x < bytesX; x += 1)
+        {
+            raw.push_back(~image[y * bytesX + x]);
+        }
+    }
+
+    // zlib stream with stored deflate blocks
+    std::vector<uint8_t> data = { 0x78, 0x01 };
+    uint32_t adlerA = 1;
+    uint32_t adlerB = 0;
+    uint32_t index = 0;
+    do
+    {
+        uint32_t size = std::min((uint32_t)raw.size() - index, (uint32_t)0xffff);
+        data.push_back((index + size == raw.size()) ? 1 : 0); // final block
+        data.push_back(size);
+        data.push_back(size >> 8);
+        data.push_back(~size);
+        data.push_back(~size >> 8);
+        for (uint32_t offset = 0; offset < size; offset += 1)
+        {
+            uint8_t value = raw[index + offset];
+            data.push_back(value);
+            adlerA = (adlerA + value) % 65521;
+            adlerB = (adlerB + adlerA) % 65521;
+        }
+        index += size;
+    }
+    while (index < raw.size());
+    h_appendBigEndian(data, (adlerB << 16) | adlerA);
+    h_writeChunk(file, "IDAT", data);
+
+    h_writeChunk(file, "IEND", std::vector<uint8_t>());
+}
+
+bool hV_HAL_Host_writeImage(const char * fileName, uint8_t format, const uint8_t * image, uint16_t sizeX, uint16_t sizeY)
+{
+    FILE * file = fopen(fileName, "wb");
+    if (file == 0)
+    {
+        return false;
+    }
+
+    if (format == HOST_IMAGE_PNG)
+    {
+        h_writePNG(file, image, sizeX, sizeY);
+    }
+    else
+    {
+        fprintf(file, "P4\n%u %u\n", sizeX, sizeY);
+        fwrite(image, 1, (sizeX + 7) / 8 * sizeY, file);
+    }
+
+    bool result = (ferror(file) == 0);
+    fclose(file);
+    return result;
+}
+
+static bool h_readNumber(FILE * file, uint32_t & number)
+{
+    int character = fgetc(file);
+
+    // Skip white spaces and comments
+    while ((character == '#') or isspace(character))
+    {
+        if (character == '#')
+        {
+            while ((character != '\n') and (character != EOF))
+            {
+                character = fgetc(file);
+            }
+        }
+        character = fgetc(file);
+    }
+
+    if (not isdigit(character))
+    {
+        return false;
+    }
+
+    number = 0;
+    while (isdigit(character))
+    {
+        number = number * 10 + (character - '0');
+        character = fgetc(file);
+    }
+    // Single white space before data
+    return isspace(character);
+}
+
+bool hV_HAL_Host_readImage(const char * fileName, uint8_t * image, uint16_t sizeX, uint16_t sizeY)
+{
+    FILE * file = fopen(fileName, "rb");
+    if (file == 0)
+    {
+        return false;
+    }
+
+    bool result = false;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    if ((fgetc(file) == 'P') and (fgetc(file) == '4') and h_readNumber(file, width) and h_readNumber(file, height))
+    {
+        if ((width == sizeX) and (height == sizeY))
+        {
+            uint32_t size = (sizeX + 7) / 8 * sizeY;
+            result = (fread(image, 1, size, file) == size);
+        }
+    }
+
+    fclose(file);
+    return result;
+}
+//
+// === End of Image section
+//
+
+//
+// === Program section
+//
+static int h_exitCode = 0;
+
+void hV_HAL_Host_setExitCode(int code)
+{
+    h_exitCode = code;
+}
+
+// Sketch functions, optional when the program provides its own main()
+extern void setup() __attribute__((weak));
+extern void loop() __attribute__((weak));
+
+__attribute__((weak)) int main(int argc, char ** argv)
+{
+    uint32_t loops = 1;
+    const char * fileRecord = 0;
+    int option;
+
+    while ((option = getopt(argc, argv, "l:r:")) != -1)
+    {
+        switch (option)
+        {
+            case 'l':
+
+                loops = (uint32_t)strtoul(optarg, 0, 10);
+                break;
+
+            case 'r':
+
+                fileRecord = optarg;
+                hV_HAL_Host_record(true);
+                break;
+
+            default:
+
+                fprintf(stderr, "Usage: %s [-l loops] [-r events.csv]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    if (setup != 0)
+    {
+        setup();
+    }
+
+    if (loop != 0)
+    {
+        for (uint32_t index = 0; index < loops; index += 1)
+        {
+            loop();
+        }
+    }
+
+    if (fileRecord != 0)
+    {
+        FILE * file = fopen(fileRecord, "w");
+        if (file != 0)
+        {
+            hV_HAL_Host_dumpEvents(file);
+            fclose(file);
+        }
+        else
+        {
+            fprintf(stderr, "hV * Host: cannot write %s\n", fileRecord);
+        }
+    }
+
+    fflush(stdout);
+    return h_exitCode;
+}
+//
+// === End of Program section
+//
+
+#endif // hV_HAL_HOST
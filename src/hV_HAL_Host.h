@@ -0,0 +1,443 @@
+///
+/// @file hV_HAL_Host.h
+/// @brief Host back-end for the light hardware abstraction layer
+///
+/// @details Project Pervasive Displays Library Suite
+/// @n Based on highView technology
+///
+/// @n The host back-end replaces the Arduino SDK on a Linux workstation.
+/// It provides the subset of the Arduino API used by the library and records
+/// every SPI byte, GPIO write and read, 3-wire SPI byte and Wire transaction with a timestamp.
+///
+/// @n Build with hV_HAL_HOST defined, for example
+/// @code
+/// g++ -std=gnu++17 -DhV_HAL_HOST -Isrc -x c++ examples/Fast/Fast_Speed/Fast_Speed.ino -x none src/*.cpp -o Fast_Speed
+/// ./Fast_Speed -r events.csv
+/// @endcode
+///
+/// @n Time
+/// * micros() and millis() return the host time plus the simulated time
+/// * delay() and delayMicroseconds() add simulated time and return immediately
+/// * SPI and Wire transfers add the simulated time of the bus at the selected speed
+///
+/// @author Rei Vilo
+/// @date 21 Feb 2025
+/// @version 820
+///
+/// @copyright (c) Rei Vilo, 2010-2025
+/// @copyright All rights reserved
+/// @copyright For exclusive use with Pervasive Displays screens
+///
+/// * Basic edition: for hobbyists and for basic usage
+/// @n Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+/// @see https://creativecommons.org/licenses/by-sa/4.0/
+///
+/// @n Consider the Evaluation or Commercial editions for professionals or organisations and for commercial usage
+///
+/// * Evaluation edition: for professionals or organisations, evaluation only, no commercial usage
+/// @n All rights reserved
+///
+/// * Commercial edition: for professionals or organisations, commercial usage
+/// @n All rights reserved
+///
+/// * Viewer edition: for professionals or organisations
+/// @n All rights reserved
+///
+/// * Documentation
+/// @n All rights reserved
+///
+
+#if defined(hV_HAL_HOST)
+
+#ifndef hV_HAL_HOST_RELEASE
+///
+/// @brief Release
+///
+#define hV_HAL_HOST_RELEASE 820
+
+///
+/// @brief Standard libraries
+///
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+#include <algorithm>
+
+///
+/// @name Arduino SDK subset
+/// @{
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x01
+#define SPI_MODE2 0x02
+#define SPI_MODE3 0x03
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#define SCK 18 ///< Host default for 3-wire SPI clock
+#define MOSI 19 ///< Host default for 3-wire SPI data
+
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+
+using std::min;
+using std::max;
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t level);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+uint32_t millis();
+uint32_t micros();
+void yield();
+
+long map(long value, long fromLow, long fromHigh, long toLow, long toHigh);
+long random(long howBig);
+long random(long howSmall, long howBig);
+void randomSeed(unsigned long seed);
+
+///
+/// @brief String object
+/// @details Subset of the Arduino String API
+///
+class String
+{
+  public:
+    String(const char * text = "");
+    String(const std::string & text);
+    String(char c);
+    String(int value, uint8_t base = DEC);
+    String(unsigned int value, uint8_t base = DEC);
+    String(long value, uint8_t base = DEC);
+    String(unsigned long value, uint8_t base = DEC);
+    String(double value, uint8_t decimals = 2);
+
+    unsigned int length() const;
+    char charAt(unsigned int index) const;
+    const char * c_str() const;
+    String substring(unsigned int beginIndex) const;
+    String substring(unsigned int beginIndex, unsigned int endIndex) const;
+    void toCharArray(char * buffer, unsigned int bufferSize) const;
+    int indexOf(char c) const;
+    long toInt() const;
+
+    String & operator+=(const String & other);
+    char operator[](unsigned int index) const;
+    bool operator==(const String & other) const;
+    bool operator!=(const String & other) const;
+
+    friend String operator+(const String & left, const String & right);
+
+  private:
+    std::string _text;
+};
+
+///
+/// @brief Serial console
+/// @details Subset of the Arduino Print API, writes to stdout
+///
+class hV_HAL_Host_Serial
+{
+  public:
+    void begin(uint32_t speed);
+    void flush();
+    operator bool() const;
+
+    size_t print(const String & text);
+    size_t print(const char * text);
+    size_t print(char c);
+    size_t print(unsigned char value, int base = DEC);
+    size_t print(int value, int base = DEC);
+    size_t print(unsigned int value, int base = DEC);
+    size_t print(long value, int base = DEC);
+    size_t print(unsigned long value, int base = DEC);
+    size_t print(double value, int decimals = 2);
+
+    size_t println();
+    template <typename T> size_t println(T value)
+    {
+        size_t result = print(value);
+        return result + println();
+    }
+    template <typename T> size_t println(T value, int option)
+    {
+        size_t result = print(value, option);
+        return result + println();
+    }
+
+    size_t printf(const char * format, ...);
+};
+
+extern hV_HAL_Host_Serial Serial;
+
+/// @}
+
+///
+/// @name Recorder
+/// @{
+
+///
+/// @brief Kinds of recorded events
+/// @note Numbers are sequential and exclusive
+///
+#define HOST_EVENT_PIN_MODE 0x01 ///< pinMode(), pin and mode
+#define HOST_EVENT_PIN_WRITE 0x02 ///< digitalWrite(), pin and level
+#define HOST_EVENT_PIN_READ 0x03 ///< digitalRead(), pin and level
+#define HOST_EVENT_SPI 0x10 ///< SPI byte, value = sent << 8 | received
+#define HOST_EVENT_SPI3_WRITE 0x11 ///< 3-wire SPI byte written
+#define HOST_EVENT_SPI3_READ 0x12 ///< 3-wire SPI byte read
+#define HOST_EVENT_WIRE_WRITE 0x20 ///< Wire byte written, pin = address
+#define HOST_EVENT_WIRE_READ 0x21 ///< Wire byte read, pin = address
+#define HOST_EVENT_DELAY 0x30 ///< delay() or delayMicroseconds(), value in us
+
+///
+/// @brief Recorded event
+///
+struct hV_HAL_Host_event_t
+{
+    uint32_t time; ///< timestamp in us, same time base as micros()
+    uint8_t kind; ///< HOST_EVENT_...
+    uint8_t pin; ///< pin number or I2C address
+    uint32_t value; ///< level, byte or duration
+};
+
+///
+/// @brief Start or stop recording
+/// @param flag true = record events, false = stop recording
+/// @note Recording is off by default
+///
+void hV_HAL_Host_record(bool flag = true);
+
+///
+/// @brief Number of recorded events
+/// @return number of events
+///
+uint32_t hV_HAL_Host_getEventsCount();
+
+///
+/// @brief Recorded events
+/// @return pointer to the first event
+///
+const hV_HAL_Host_event_t * hV_HAL_Host_getEvents();
+
+///
+/// @brief Clear the recorded events
+///
+void hV_HAL_Host_clearEvents();
+
+///
+/// @brief Dump the recorded events as CSV
+/// @param file destination, default = stdout
+/// @note Columns are time in us, kind, pin or address, value
+///
+void hV_HAL_Host_dumpEvents(FILE * file = stdout);
+
+/// @}
+
+///
+/// @name Simulated devices
+/// @{
+
+///
+/// @brief Simulated device attached to the host buses and GPIOs
+/// @details Override the relevant functions, default behaviour is no device
+///
+class hV_HAL_Host_Device
+{
+  public:
+    virtual ~hV_HAL_Host_Device() = default;
+
+    ///
+    /// @brief Called after a pin has changed
+    /// @param pin pin
+    /// @param level new level
+    ///
+    virtual void onPinWrite(uint8_t /* pin */, uint8_t /* level */) {}
+
+    ///
+    /// @brief Called on pin read
+    /// @param pin pin
+    /// @param[out] level level to update when the device drives the pin
+    ///
+    virtual void onPinRead(uint8_t /* pin */, uint8_t & /* level */) {}
+
+    ///
+    /// @brief Called for each SPI byte
+    /// @param data byte sent
+    /// @param[out] result byte received, to update when the device drives MISO
+    ///
+    virtual void onSPI(uint8_t /* data */, uint8_t & /* result */) {}
+
+    ///
+    /// @brief Called for each 3-wire SPI byte written
+    /// @param data byte written
+    ///
+    virtual void onSPI3Write(uint8_t /* data */) {}
+
+    ///
+    /// @brief Called for each 3-wire SPI byte read
+    /// @param[out] result byte read, to update when the device drives SDIO
+    ///
+    virtual void onSPI3Read(uint8_t & /* result */) {}
+
+    ///
+    /// @brief Called for each Wire transaction
+    /// @param address I2C address
+    /// @param dataWrite bytes written
+    /// @param sizeWrite number of bytes written
+    /// @param[out] dataRead bytes read, to update when the device answers
+    /// @param sizeRead number of bytes read
+    /// @return true if the device answered
+    ///
+    virtual bool onWire(uint8_t /* address */, const uint8_t * /* dataWrite */, size_t /* sizeWrite */, uint8_t * /* dataRead */, size_t /* sizeRead */)
+    {
+        return false;
+    }
+};
+
+///
+/// @brief Attach a simulated device
+/// @param device pointer to the device
+/// @note Up to 4 devices
+///
+void hV_HAL_Host_attach(hV_HAL_Host_Device * device);
+
+///
+/// @brief Detach a simulated device
+/// @param device pointer to the device
+///
+void hV_HAL_Host_detach(hV_HAL_Host_Device * device);
+
+///
+/// @brief Set the level of an input pin
+/// @param pin pin
+/// @param level level
+/// @note Used by simulated devices and test scenarios
+///
+void hV_HAL_Host_setPin(uint8_t pin, uint8_t level);
+
+///
+/// @brief Get the level of a pin
+/// @param pin pin
+/// @return level
+///
+uint8_t hV_HAL_Host_getPin(uint8_t pin);
+
+/// @}
+
+///
+/// @name Bus back-end
+/// @note Called by hV_HAL_Peripherals.cpp
+/// @{
+
+void hV_HAL_Host_SPI_begin(uint32_t speed);
+uint8_t hV_HAL_Host_SPI_transfer(uint8_t data);
+void hV_HAL_Host_SPI3_write(uint8_t data);
+uint8_t hV_HAL_Host_SPI3_read();
+void hV_HAL_Host_Wire_transfer(uint8_t address, uint8_t * dataWrite, size_t sizeWrite, uint8_t * dataRead, size_t sizeRead);
+
+/// @}
+
+///
+/// @name Time
+/// @{
+
+#define HOST_CLOCK_HYBRID 0 ///< Host time plus simulated time, default
+#define HOST_CLOCK_SIMULATED 1 ///< Simulated time only, deterministic
+
+///
+/// @brief Select the time base
+/// @param mode HOST_CLOCK_HYBRID or HOST_CLOCK_SIMULATED
+///
+void hV_HAL_Host_setClock(uint8_t mode);
+
+///
+/// @brief Add simulated time
+/// @param ns duration in ns
+///
+void hV_HAL_Host_addTime(uint64_t ns);
+
+///
+/// @brief Current time
+/// @return time in ns, same time base as micros()
+///
+uint64_t hV_HAL_Host_getTime();
+
+/// @}
+
+///
+/// @name Image
+/// @details Images are 1 bit per pixel, 1 = black, most significant bit first,
+/// with lines of (sizeX + 7) / 8 bytes
+/// @{
+
+#define HOST_IMAGE_PBM 0 ///< Portable bitmap, binary P4
+#define HOST_IMAGE_PNG 1 ///< PNG, 1-bit grey, stored without compression
+
+///
+/// @brief Write an image into a file
+/// @param fileName name of the file
+/// @param format HOST_IMAGE_PBM or HOST_IMAGE_PNG
+/// @param image image
+/// @param sizeX width in pixels
+/// @param sizeY height in pixels
+/// @return true if successful, false otherwise
+///
+bool hV_HAL_Host_writeImage(const char * fileName, uint8_t format, const uint8_t * image, uint16_t sizeX, uint16_t sizeY);
+
+///
+/// @brief Read an image from a file
+/// @param fileName name of the file, PBM binary P4 only
+/// @param image image, with (sizeX + 7) / 8 * sizeY bytes
+/// @param sizeX expected width in pixels
+/// @param sizeY expected height in pixels
+/// @return true if successful, false otherwise or if the sizes differ
+///
+bool hV_HAL_Host_readImage(const char * fileName, uint8_t * image, uint16_t sizeX, uint16_t sizeY);
+
+/// @}
+
+///
+/// @name Program
+/// @details The host provides main(), which calls setup() and then loop()
+/// @n Options
+/// * -l number of calls to loop(), default = 1
+/// * -r file to dump the recorded events into, with recording on from the start
+/// @{
+
+///
+/// @brief Set the exit code returned by main()
+/// @param code exit code, 0 = success
+///
+void hV_HAL_Host_setExitCode(int code);
+
+/// @}
+
+#endif // hV_HAL_HOST_RELEASE
+
+#endif // hV_HAL_HOST
@@ -0,0 +1,585 @@
+//
+// hV_HAL_Host_Panel.cpp
+// C++ code
+// ----------------------------------
+//
+// Project highView Library Suite
+//
+// Created by Rei Vilo, 21 Feb 2025
+//
+// Copyright (c) Rei Vilo, 2010-2025
+// Licence All rights reserved
+//
+// * Basic edition: for hobbyists and for basic usage
+// Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+//
+// * Evaluation edition: for professionals or organisations, evaluation only, no commercial usage
+// All rights reserved
+//
+// * Commercial edition: for professionals or organisations, commercial usage
+// All rights reserved
+//
+// Release 820: Added emulated panel for host back-end
+//
+
+// The Arduino IDE does not allow to select the files, hence this condition.
+#if defined(hV_HAL_HOST)
+
+// Library header
+#include "hV_HAL_Host_Panel.h"
+
+//
+// === Configuration section
+//
+// Nominal durations at 25 Celsius, ms
+#define PANEL_TIME_RESET 2 // Soft-reset
+#define PANEL_TIME_POWER_ON 40 // Power on
+#define PANEL_TIME_POWER_OFF 20 // Power off
+
+#define PANEL_SIZE_OTP_MEDIUM 128
+#define PANEL_SIZE_OTP_SMALL 0x2000
+//
+// === End of Configuration section
+//
+
+//
+// === Class section
+//
+hV_HAL_Host_Panel::hV_HAL_Host_Panel(eScreen_EPD_t eScreen_EPD, pins_t board)
+{
+    p_eScreen_EPD = eScreen_EPD;
+    p_pin = board;
+
+    switch (SCREEN_SIZE(p_eScreen_EPD))
+    {
+        case SIZE_271: // 2.71" and 2.71"-Touch
+
+            p_family = FAMILY_SMALL;
+            p_sizeV = 264; // vertical = wide size
+            p_sizeH = 176; // horizontal = small size
+            p_timeUpdate[0] = 2000; // UPDATE_GLOBAL
+            p_timeUpdate[1] = 400; // UPDATE_FAST
+            break;
+
+        case SIZE_343: // 3.43" and 3.43"-Touch
+
+            p_family = FAMILY_MEDIUM;
+            p_sizeV = 392; // vertical = wide size
+            p_sizeH = 456; // horizontal = small size
+            p_timeUpdate[0] = 3200; // UPDATE_GLOBAL
+            p_timeUpdate[1] = 600; // UPDATE_FAST
+            break;
+
+        case SIZE_370: // 3.70" and 3.70"-Touch
+
+            p_family = FAMILY_SMALL;
+            p_sizeV = 416; // vertical = wide size
+            p_sizeH = 240; // horizontal = small size
+            p_timeUpdate[0] = 2500; // UPDATE_GLOBAL
+            p_timeUpdate[1] = 500; // UPDATE_FAST
+            break;
+
+        default:
+
+            fprintf(stderr, "hV * Host: panel %i-%cS-0%c not emulated\n", SCREEN_SIZE(p_eScreen_EPD), SCREEN_FILM(p_eScreen_EPD), SCREEN_DRIVER(p_eScreen_EPD));
+            p_family = FAMILY_SMALL;
+            p_sizeV = 8;
+            p_sizeH = 8;
+            p_timeUpdate[0] = 0;
+            p_timeUpdate[1] = 0;
+            break;
+    }
+
+    p_bytesH = p_sizeH / 8;
+    p_pageSize = (uint32_t)p_sizeV * (uint32_t)p_bytesH;
+
+    p_nextRAM.assign(p_pageSize, 0x00);
+    p_previousRAM.assign(p_pageSize, 0x00);
+    p_image.assign(p_pageSize, 0x00);
+
+    // OTP memory
+    if (p_family == FAMILY_MEDIUM)
+    {
+        p_OTP.assign(PANEL_SIZE_OTP_MEDIUM, 0x00);
+
+        p_OTP[0x00] = 0x10; // Chip ID
+        p_OTP[0x0b] = 0x00; // TCON
+        p_OTP[0x0c] = 0x00; // DRFW
+        p_OTP[0x0d] = p_bytesH - 1;
+        p_OTP[0x0e] = 0x00;
+        p_OTP[0x0f] = (p_sizeV - 1) / 2;
+        p_OTP[0x10] = 0x00; // DCTL
+        p_OTP[0x11] = 0x0e; // VCOM
+        p_OTP[0x12] = 0x00; // RAM_RW
+        p_OTP[0x13] = 0x00;
+        p_OTP[0x14] = 0x00;
+        p_OTP[0x15] = 0x00; // DUW
+        p_OTP[0x16] = p_bytesH - 1;
+        p_OTP[0x17] = 0x00;
+        p_OTP[0x18] = 0x00;
+        p_OTP[0x19] = (p_sizeV - 1) >> 8;
+        p_OTP[0x1a] = (p_sizeV - 1) & 0xff;
+        p_OTP[0x1b] = 0x00; // STV_DIR
+        p_OTP[0x1c] = 0x00; // MS_SYNC
+        p_OTP[0x1d] = 0x00; // BVSS
+
+        // DC/DC soft-start, 4 stages with format 2, one repeat of 2 x 1 ms
+        for (uint8_t stage = 0; stage < 4; stage += 1)
+        {
+            uint8_t offset = 0x28 + 0x08 * stage;
+            p_OTP[offset + 0] = 0x01; // FORMAT 2, REPEAT 1
+            p_OTP[offset + 1] = 0x00; // BST_SW_a
+            p_OTP[offset + 2] = 0x00; // BST_SW_b
+            p_OTP[offset + 3] = 0x81; // DELAY_a = 1 ms
+            p_OTP[offset + 4] = 0x81; // DELAY_b = 1 ms
+        }
+    }
+    else
+    {
+        p_OTP.assign(PANEL_SIZE_OTP_SMALL, 0xff);
+
+        // Bank 0, PSR after 0xa5 marker
+        uint16_t offsetPSR = (SCREEN_DRIVER(p_eScreen_EPD) == DRIVER_9) ? 0x004b : 0x0fb4;
+        p_OTP[0x0000] = 0xa5;
+        p_OTP[offsetPSR + 0] = 0xcf; // PSR0
+        p_OTP[offsetPSR + 1] = 0x82; // PSR1
+    }
+
+    p_refreshCount = 0;
+    p_refreshMode = UPDATE_NONE;
+    p_mismatchCount = 0;
+    p_addressOTP = -1;
+    p_flagCS = false;
+    p_flagDC = true;
+    p_reset();
+}
+
+void hV_HAL_Host_Panel::begin()
+{
+    hV_HAL_Host_attach(this);
+}
+
+void hV_HAL_Host_Panel::end()
+{
+    hV_HAL_Host_detach(this);
+}
+
+void hV_HAL_Host_Panel::setUpdateTime(uint8_t updateMode, uint32_t ms)
+{
+    switch (updateMode)
+    {
+        case UPDATE_GLOBAL:
+
+            p_timeUpdate[0] = ms;
+            break;
+
+        case UPDATE_FAST:
+
+            p_timeUpdate[1] = ms;
+            break;
+
+        default:
+
+            break;
+    }
+}
+
+const uint8_t * hV_HAL_Host_Panel::getImage()
+{
+    return p_image.data();
+}
+
+uint32_t hV_HAL_Host_Panel::getImageSize()
+{
+    return p_pageSize;
+}
+
+uint16_t hV_HAL_Host_Panel::getSizeV()
+{
+    return p_sizeV;
+}
+
+uint16_t hV_HAL_Host_Panel::getSizeH()
+{
+    return p_sizeH;
+}
+
+uint32_t hV_HAL_Host_Panel::getRefreshCount()
+{
+    return p_refreshCount;
+}
+
+uint8_t hV_HAL_Host_Panel::getRefreshMode()
+{
+    return p_refreshMode;
+}
+
+uint32_t hV_HAL_Host_Panel::getMismatchCount()
+{
+    return p_mismatchCount;
+}
+//
+// === End of Class section
+//
+
+//
+// === Device section
+//
+void hV_HAL_Host_Panel::p_reset()
+{
+    p_index = 0x00;
+    p_count = 0;
+    p_flagFast = false;
+    p_busyUntil = 0;
+
+    p_windowX0 = 0;
+    p_windowX1 = p_bytesH - 1;
+    p_windowY0 = 0;
+    p_windowY1 = p_sizeV - 1;
+    p_refreshX0 = p_windowX0;
+    p_refreshX1 = p_windowX1;
+    p_refreshY0 = p_windowY0;
+    p_refreshY1 = p_windowY1;
+    p_addressX = 0;
+    p_addressY = 0;
+}
+
+void hV_HAL_Host_Panel::p_busy(uint32_t ms)
+{
+    p_busyUntil = hV_HAL_Host_getTime() + (uint64_t)ms * 1000000ULL;
+}
+
+void hV_HAL_Host_Panel::onPinWrite(uint8_t pin, uint8_t level)
+{
+    if (pin == NOT_CONNECTED)
+    {
+        return;
+    }
+
+    if (pin == p_pin.panelCS)
+    {
+        p_flagCS = (level == LOW); // LOW = selected
+    }
+    else if (pin == p_pin.panelDC)
+    {
+        p_flagDC = (level == HIGH); // HIGH = data
+    }
+    else if ((pin == p_pin.panelReset) and (level == LOW))
+    {
+        p_reset();
+    }
+}
+
+void hV_HAL_Host_Panel::onPinRead(uint8_t pin, uint8_t & level)
+{
+    if ((pin == p_pin.panelBusy) and (pin != NOT_CONNECTED))
+    {
+        // LOW = busy, HIGH = ready, except for DRIVER_J
+        bool flagBusy = (hV_HAL_Host_getTime() < p_busyUntil);
+        uint8_t levelBusy = (SCREEN_DRIVER(p_eScreen_EPD) == DRIVER_J) ? HIGH : LOW;
+        level = flagBusy ? levelBusy : !levelBusy;
+    }
+}
+
+void hV_HAL_Host_Panel::onSPI3Write(uint8_t data)
+{
+    switch (data)
+    {
+        case 0xb9: // Medium OTP
+        case 0xa2: // Small OTP
+
+            p_addressOTP = -1; // Dummy byte first
+            break;
+
+        default:
+
+            break;
+    }
+}
+
+void hV_HAL_Host_Panel::onSPI3Read(uint8_t & result)
+{
+    if (p_addressOTP < 0)
+    {
+        result = 0x00; // Dummy
+        p_addressOTP = 0;
+    }
+    else if ((uint32_t)p_addressOTP < p_OTP.size())
+    {
+        result = p_OTP[p_addressOTP];
+        p_addressOTP += 1;
+    }
+}
+
+void hV_HAL_Host_Panel::onSPI(uint8_t data, uint8_t & /* result */)
+{
+    if (p_flagCS == false)
+    {
+        return;
+    }
+
+    if (p_flagDC == false) // Command
+    {
+        p_index = data;
+        p_count = 0;
+
+        if (p_family == FAMILY_SMALL)
+        {
+            p_decodeSmall(data);
+        }
+    }
+    else // Data
+    {
+        if (p_count < sizeof(p_data))
+        {
+            p_data[p_count] = data;
+        }
+
+        if (p_family == FAMILY_MEDIUM)
+        {
+            p_decodeMedium(data);
+        }
+        else
+        {
+            p_decodeSmall(data);
+        }
+        p_count += 1;
+    }
+}
+
+void hV_HAL_Host_Panel::p_writeRAM(std::vector<uint8_t> & memory, uint8_t data)
+{
+    uint32_t address = (uint32_t)p_addressY * p_bytesH + p_addressX;
+    if (address < p_pageSize)
+    {
+        memory[address] = data;
+    }
+
+    // Next address within DUW window
+    p_addressX += 1;
+    if (p_addressX > p_windowX1)
+    {
+        p_addressX = p_windowX0;
+        p_addressY += 1;
+        if (p_addressY > p_windowY1)
+        {
+            p_addressY = p_windowY0;
+        }
+    }
+}
+
+void hV_HAL_Host_Panel::p_refresh(uint16_t x0, uint16_t x1, uint16_t y0, uint16_t y1)
+{
+    x1 = min(x1, (uint16_t)(p_bytesH - 1));
+    y1 = min(y1, (uint16_t)(p_sizeV - 1));
+
+    for (uint16_t y = y0; y <= y1; y += 1)
+    {
+        for (uint16_t x = x0; x <= x1; x += 1)
+        {
+            uint32_t address = (uint32_t)y * p_bytesH + x;
+
+            if (p_flagFast and (p_previousRAM[address] != p_image[address]))
+            {
+                p_mismatchCount += 1;
+            }
+            p_image[address] = p_nextRAM[address];
+        }
+    }
+
+    p_refreshCount += 1;
+    p_refreshMode = p_flagFast ? UPDATE_FAST : UPDATE_GLOBAL;
+    p_busy(p_timeUpdate[p_flagFast ? 1 : 0]);
+}
+
+void hV_HAL_Host_Panel::p_decodeMedium(uint8_t data)
+{
+    switch (p_index)
+    {
+        case 0x10: // Next frame
+
+            p_writeRAM(p_nextRAM, data);
+            break;
+
+        case 0x11: // Previous frame
+
+            p_writeRAM(p_previousRAM, data);
+            break;
+
+        case 0x12: // RAM_RW
+
+            if (p_count == 2)
+            {
+                p_addressX = p_data[0];
+                p_addressY = (p_data[1] << 8) | p_data[2];
+            }
+            break;
+
+        case 0x13: // DUW
+
+            if (p_count == 5)
+            {
+                p_windowX0 = p_data[0];
+                p_windowX1 = p_data[1];
+                p_windowY0 = (p_data[2] << 8) | p_data[3];
+                p_windowY1 = (p_data[4] << 8) | p_data[5];
+            }
+            break;
+
+        case 0x90: // DRFW
+
+            if (p_count == 3)
+            {
+                p_refreshX0 = p_data[0];
+                p_refreshX1 = p_data[1];
+                p_refreshY0 = p_data[2] * 2;
+                p_refreshY1 = p_data[3] * 2 + 1;
+            }
+            break;
+
+        case 0x45: // Temperature index, after 0x44 = 0x06
+
+            // Global update uses 0x50..0xb4 on 343_PS_0B, fast update above
+            p_flagFast = (data > 0xb4);
+            break;
+
+        case 0x15: // Display refresh
+
+            if (data == 0x3c)
+            {
+                p_refresh(p_refreshX0, p_refreshX1, p_refreshY0, p_refreshY1);
+            }
+            break;
+
+        default:
+
+            break;
+    }
+}
+
+void hV_HAL_Host_Panel::p_decodeSmall(uint8_t data)
+{
+    bool flagDriverJ = (SCREEN_DRIVER(p_eScreen_EPD) == DRIVER_J);
+
+    if (p_flagDC == false) // Command without data
+    {
+        switch (p_index)
+        {
+            case 0x04: // Power on
+
+                p_busy(PANEL_TIME_POWER_ON);
+                break;
+
+            case 0x02: // Power off
+
+                p_busy(PANEL_TIME_POWER_OFF);
+                break;
+
+            case 0x12: // Display refresh, soft-reset for DRIVER_J
+
+                if (flagDriverJ)
+                {
+                    p_busy(PANEL_TIME_RESET);
+                }
+                else
+                {
+                    p_refresh(0, p_bytesH - 1, 0, p_sizeV - 1);
+                }
+                break;
+
+            case 0x20: // Display refresh for DRIVER_J
+
+                if (flagDriverJ)
+                {
+                    p_refresh(0, p_bytesH - 1, 0, p_sizeV - 1);
+                }
+                break;
+
+            default:
+
+                break;
+        }
+        return;
+    }
+
+    switch (p_index)
+    {
+        case 0x00: // Soft-reset or PSR
+
+            if ((p_count == 0) and (data == 0x0e))
+            {
+                p_busy(PANEL_TIME_RESET);
+            }
+            break;
+
+        case 0xe5: // Input temperature, 0x40 = fast update
+
+            p_flagFast = ((data & 0x40) == 0x40);
+            break;
+
+        case 0x22: // Display update control for DRIVER_J
+
+            p_flagFast = (data == 0xdf);
+            break;
+
+        case 0x10: // First frame
+        case 0x26: // Previous frame for DRIVER_J
+
+            if (p_count < p_pageSize)
+            {
+                p_previousRAM[p_count] = data;
+            }
+            break;
+
+        case 0x13: // Second frame
+        case 0x24: // Next frame for DRIVER_J
+
+            if (p_count < p_pageSize)
+            {
+                p_nextRAM[p_count] = data;
+            }
+            break;
+
+        default:
+
+            break;
+    }
+}
+//
+// === End of Device section
+//
+
+//
+// === Default panel section
+//
+static hV_HAL_Host_Panel * h_panel = 0;
+static eScreen_EPD_t h_panelScreen = 0;
+
+hV_HAL_Host_Panel * hV_HAL_Host_beginPanel(eScreen_EPD_t eScreen_EPD, pins_t board)
+{
+    // Replace the panel for another screen
+    if ((h_panel != 0) and (h_panelScreen != eScreen_EPD))
+    {
+        h_panel->end();
+        delete h_panel;
+        h_panel = 0;
+    }
+
+    if (h_panel == 0)
+    {
+        h_panelScreen = eScreen_EPD;
+        h_panel = new hV_HAL_Host_Panel(eScreen_EPD, board);
+        h_panel->begin();
+    }
+    return h_panel;
+}
+
+hV_HAL_Host_Panel * hV_HAL_Host_getPanel()
+{
+    return h_panel;
+}
+//
+// === End of Default panel section
+//
+
+#endif // hV_HAL_HOST
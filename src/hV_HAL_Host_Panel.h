@@ -0,0 +1,221 @@
+///
+/// @file hV_HAL_Host_Panel.h
+/// @brief Emulated EXT3 panel for the host back-end
+///
+/// @details Project Pervasive Displays Library Suite
+/// @n Based on highView technology
+///
+/// @n The emulated panel decodes the byte stream sent by hV_Board on the 4-wire SPI bus,
+/// answers the OTP reads on the 3-wire SPI bus and drives the busy pin.
+/// It rebuilds the displayed image with the same layout as one page of the frame-buffer.
+///
+/// @n Registers
+/// * Medium COG: 0x10 next frame, 0x11 previous frame, 0x12 RAM_RW, 0x13 DUW, 0x90 DRFW, 0x15 refresh
+/// * Small COG: 0x10 first frame, 0x13 second frame, 0x24 and 0x26 frames, 0x04 power on, 0x12 and 0x20 refresh, 0x02 power off
+///
+/// @n Windows on the Medium COG, as emulated
+/// * DUW = source start byte, source end byte, gate start MSB, gate start LSB, gate end MSB, gate end LSB
+/// * DRFW = source start byte, source end byte, gate start / 2, gate end / 2
+/// * RAM_RW = source byte, gate MSB, gate LSB
+///
+/// @author Rei Vilo
+/// @date 21 Feb 2025
+/// @version 820
+///
+/// @copyright (c) Rei Vilo, 2010-2025
+/// @copyright All rights reserved
+/// @copyright For exclusive use with Pervasive Displays screens
+///
+/// * Basic edition: for hobbyists and for basic usage
+/// @n Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+/// @see https://creativecommons.org/licenses/by-sa/4.0/
+///
+/// @n Consider the Evaluation or Commercial editions for professionals or organisations and for commercial usage
+///
+/// * Evaluation edition: for professionals or organisations, evaluation only, no commercial usage
+/// @n All rights reserved
+///
+/// * Commercial edition: for professionals or organisations, commercial usage
+/// @n All rights reserved
+///
+/// * Viewer edition: for professionals or organisations
+/// @n All rights reserved
+///
+/// * Documentation
+/// @n All rights reserved
+///
+
+#if defined(hV_HAL_HOST)
+
+#ifndef hV_HAL_HOST_PANEL_RELEASE
+///
+/// @brief Release
+///
+#define hV_HAL_HOST_PANEL_RELEASE 820
+
+///
+/// @brief Host back-end
+///
+#include "hV_HAL_Host.h"
+
+///
+/// @brief Configuration
+///
+#include "hV_List_Constants.h"
+#include "hV_List_Boards.h"
+#include "hV_List_Screens.h"
+
+///
+/// @brief Standard libraries
+///
+#include <vector>
+
+///
+/// @brief Emulated EXT3 panel
+/// @details Supports the 2.71", 3.43" and 3.70" screens, with Small and Medium COG
+///
+class hV_HAL_Host_Panel : public hV_HAL_Host_Device
+{
+  public:
+    ///
+    /// @brief Constructor
+    /// @param eScreen_EPD size and model of the e-screen
+    /// @param board board configuration
+    ///
+    hV_HAL_Host_Panel(eScreen_EPD_t eScreen_EPD, pins_t board);
+
+    ///
+    /// @brief Attach the panel to the host back-end
+    ///
+    void begin();
+
+    ///
+    /// @brief Detach the panel from the host back-end
+    ///
+    void end();
+
+    ///
+    /// @brief Set the duration of the busy state for an update mode
+    /// @param updateMode UPDATE_GLOBAL or UPDATE_FAST
+    /// @param ms duration in ms
+    /// @note Defaults are nominal values at 25 Celsius
+    ///
+    void setUpdateTime(uint8_t updateMode, uint32_t ms);
+
+    ///
+    /// @brief Displayed image
+    /// @return pointer to the image
+    /// @note Same layout as one page of the frame-buffer, 1 = black
+    ///
+    const uint8_t * getImage();
+
+    ///
+    /// @brief Size of the displayed image
+    /// @return size in bytes
+    ///
+    uint32_t getImageSize();
+
+    ///
+    /// @brief Size along V
+    /// @return size in pixels, vertical = wide size
+    ///
+    uint16_t getSizeV();
+
+    ///
+    /// @brief Size along H
+    /// @return size in pixels, horizontal = small size
+    ///
+    uint16_t getSizeH();
+
+    ///
+    /// @brief Number of refreshes
+    /// @return number of refreshes since begin()
+    ///
+    uint32_t getRefreshCount();
+
+    ///
+    /// @brief Update mode of the last refresh
+    /// @return UPDATE_GLOBAL or UPDATE_FAST, UPDATE_NONE if none
+    ///
+    uint8_t getRefreshMode();
+
+    ///
+    /// @brief Number of mismatches between previous frame and displayed image
+    /// @return number of bytes, cumulated over all fast refreshes
+    /// @note A fast update expects the previous frame to match the displayed image
+    ///
+    uint32_t getMismatchCount();
+
+    /// @cond
+
+    void onPinWrite(uint8_t pin, uint8_t level);
+    void onPinRead(uint8_t pin, uint8_t & level);
+    void onSPI(uint8_t data, uint8_t & result);
+    void onSPI3Write(uint8_t data);
+    void onSPI3Read(uint8_t & result);
+
+    /// @endcond
+
+  private:
+    // Configuration
+    eScreen_EPD_t p_eScreen_EPD;
+    pins_t p_pin;
+    uint8_t p_family;
+    uint16_t p_sizeV, p_sizeH; // pixels
+    uint16_t p_bytesH; // bytes per line
+    uint32_t p_pageSize;
+
+    // Memories
+    std::vector<uint8_t> p_OTP;
+    std::vector<uint8_t> p_nextRAM;
+    std::vector<uint8_t> p_previousRAM;
+    std::vector<uint8_t> p_image;
+
+    // Bus state
+    bool p_flagCS;
+    bool p_flagDC;
+    uint8_t p_index; // current register
+    uint32_t p_count; // bytes received for current register
+    uint8_t p_data[8]; // first bytes received for current register
+    int32_t p_addressOTP; // -1 = dummy byte
+
+    // Medium COG windows
+    uint16_t p_windowX0, p_windowX1, p_windowY0, p_windowY1; // DUW
+    uint16_t p_refreshX0, p_refreshX1, p_refreshY0, p_refreshY1; // DRFW
+    uint16_t p_addressX, p_addressY; // RAM_RW
+
+    // Update
+    bool p_flagFast;
+    uint32_t p_timeUpdate[2]; // ms, UPDATE_GLOBAL and UPDATE_FAST
+    uint64_t p_busyUntil; // ns
+    uint32_t p_refreshCount;
+    uint8_t p_refreshMode;
+    uint32_t p_mismatchCount;
+
+    void p_reset();
+    void p_busy(uint32_t ms);
+    void p_writeRAM(std::vector<uint8_t> & memory, uint8_t data);
+    void p_refresh(uint16_t x0, uint16_t x1, uint16_t y0, uint16_t y1);
+    void p_decodeMedium(uint8_t data);
+    void p_decodeSmall(uint8_t data);
+};
+
+///
+/// @brief Default emulated panel
+/// @param eScreen_EPD size and model of the e-screen
+/// @param board board configuration
+/// @return pointer to the panel
+/// @note Created and attached on first call, called by Screen_EPD_EXT3_Fast::begin()
+/// @n Replaced when called for another screen
+///
+hV_HAL_Host_Panel * hV_HAL_Host_beginPanel(eScreen_EPD_t eScreen_EPD, pins_t board);
+
+///
+/// @brief Default emulated panel
+/// @return pointer to the panel, 0 if none
+///
+hV_HAL_Host_Panel * hV_HAL_Host_getPanel();
+
+#endif // hV_HAL_HOST_PANEL_RELEASE
+
+#endif // hV_HAL_HOST
@@ -25,6 +25,8 @@
 // Release 804: Improved power management
 // Release 805: Improved stability
 // Release 810: Added patches for some platforms
+// Release 820: Added host back-end
+// Release 820: Added trace ring buffer
 //
 
 // Library header
@@ -33,10 +35,10 @@
 //
 // === General section
 //
-#if defined(ENERGIA)
+#if defined(ENERGIA) || defined(hV_HAL_HOST)
 ///
 /// @brief Proxy for SPISettings
-/// @details Not implemented in Energia
+/// @details Not implemented in Energia nor on host
 /// @see https://www.arduino.cc/en/Reference/SPISettings
 ///
 struct _SPISettings_s
@@ -54,7 +56,7 @@ _SPISettings_s _settingScreen;
 /// @brief SPI settings for screen
 ///
 SPISettings _settingScreen;
-#endif // ENERGIA
+#endif // ENERGIA hV_HAL_HOST
 
 #ifndef SPI_CLOCK_MAX
 #define SPI_CLOCK_MAX 16000000
@@ -109,7 +111,11 @@ void hV_HAL_SPI_begin(uint32_t speed)
     {
         _settingScreen = {speed, MSBFIRST, SPI_MODE0};
 
-#if defined(ENERGIA)
+#if defined(hV_HAL_HOST)
+
+        hV_HAL_Host_SPI_begin(_settingScreen.clock);
+
+#elif defined(ENERGIA)
 
         SPI.begin();
         SPI.setBitOrder(_settingScreen.bitOrder);
@@ -136,7 +142,7 @@ void hV_HAL_SPI_begin(uint32_t speed)
 
         SPI.beginTransaction(_settingScreen);
 
-#endif // ENERGIA
+#endif // hV_HAL_HOST ENERGIA
 
         flagSPI = true;
     }
@@ -146,14 +152,20 @@ void hV_HAL_SPI_end()
 {
     if (flagSPI != false)
     {
+#if !defined(hV_HAL_HOST)
         SPI.end();
+#endif // hV_HAL_HOST
         flagSPI = false;
     }
 }
 
 uint8_t hV_HAL_SPI_transfer(uint8_t data)
 {
+#if defined(hV_HAL_HOST)
+    return hV_HAL_Host_SPI_transfer(data);
+#else
     return SPI.transfer(data);
+#endif // hV_HAL_HOST
 }
 
 //
@@ -169,9 +181,13 @@ void hV_HAL_Wire_begin()
 {
     if (flagWire == false)
     {
-        Wire.begin();
+#if defined(hV_HAL_HOST)
 
-#if defined(ENERGIA)
+        // Managed by hV_HAL_Host_Wire_transfer()
+
+#elif defined(ENERGIA)
+
+        Wire.begin();
 
 #if defined(ENERGIA_ARCH_MSP430ELF)
 
@@ -181,9 +197,10 @@ void hV_HAL_Wire_begin()
 
 #else // ARDUINO
 
+        Wire.begin();
         Wire.setClock(400000L); // 400 kHz
 
-#endif // ENERGIA ARDUINO
+#endif // hV_HAL_HOST ENERGIA ARDUINO
         flagWire = true;
     }
 }
@@ -192,13 +209,21 @@ void hV_HAL_Wire_end()
 {
     if (flagWire == true)
     {
+#if !defined(hV_HAL_HOST)
         Wire.end();
+#endif // hV_HAL_HOST
         flagWire = true;
     }
 }
 
 void hV_HAL_Wire_transfer(uint8_t address, uint8_t * dataWrite, size_t sizeWrite, uint8_t * dataRead, size_t sizeRead)
 {
+#if defined(hV_HAL_HOST)
+
+    hV_HAL_Host_Wire_transfer(address, dataWrite, sizeWrite, dataRead, sizeRead);
+
+#else
+
     if (sizeWrite > 0)
     {
         Wire.beginTransmission(address);
@@ -232,6 +257,8 @@ void hV_HAL_Wire_transfer(uint8_t address, uint8_t * dataWrite, size_t sizeWrite
             dataRead[index] = Wire.read();
         }
     }
+
+#endif // hV_HAL_HOST
 }
 //
 // === End of Wire section
@@ -268,6 +295,12 @@ void hV_HAL_SPI3_define(uint8_t pinClock, uint8_t pinData)
 
 uint8_t hV_HAL_SPI3_read()
 {
+#if defined(hV_HAL_HOST)
+
+    return hV_HAL_Host_SPI3_read();
+
+#else
+
     uint8_t value = 0;
 
     pinMode(h_pinSPI3.pinClock, OUTPUT);
@@ -283,10 +316,18 @@ uint8_t hV_HAL_SPI3_read()
     }
 
     return value;
+
+#endif // hV_HAL_HOST
 }
 
 void hV_HAL_SPI3_write(uint8_t value)
 {
+#if defined(hV_HAL_HOST)
+
+    hV_HAL_Host_SPI3_write(value);
+
+#else
+
     pinMode(h_pinSPI3.pinClock, OUTPUT);
     pinMode(h_pinSPI3.pinData, OUTPUT);
 
@@ -299,8 +340,92 @@ void hV_HAL_SPI3_write(uint8_t value)
         digitalWrite(h_pinSPI3.pinClock, LOW);
         delayMicroseconds(1);
     }
+
+#endif // hV_HAL_HOST
 }
 //
 // === End of 3-wire SPI section
 //
 
+
+//
+// === Trace section
+//
+#if (TRACE_MODE == USE_TRACE_RING)
+
+static trace_t h_traceBuffer[TRACE_SIZE];
+static uint32_t h_traceCount = 0;
+
+static const char * h_traceNames[] =
+{
+    "setPoint",
+    "flushBegin",
+    "flushEnd",
+    "sendIndex",
+    "waitBusy",
+    "touch",
+};
+
+void hV_HAL_Trace_add(uint8_t event, uint32_t argument)
+{
+    trace_t & trace = h_traceBuffer[h_traceCount % TRACE_SIZE];
+    trace.time = micros();
+    trace.event = event;
+    trace.argument = argument;
+    h_traceCount += 1;
+}
+
+uint32_t hV_HAL_Trace_getCount()
+{
+    return h_traceCount;
+}
+
+void hV_HAL_Trace_clear()
+{
+    h_traceCount = 0;
+}
+
+void hV_HAL_Trace_dump()
+{
+    uint32_t first = (h_traceCount > TRACE_SIZE) ? h_traceCount - TRACE_SIZE : 0;
+
+    mySerial.println("time,event,argument");
+    for (uint32_t index = first; index < h_traceCount; index += 1)
+    {
+        trace_t & trace = h_traceBuffer[index % TRACE_SIZE];
+        mySerial.print((unsigned long)trace.time);
+        mySerial.print(",");
+        mySerial.print(h_traceNames[trace.event]);
+        mySerial.print(",0x");
+        mySerial.println((unsigned long)trace.argument, HEX);
+    }
+}
+
+#if defined(hV_HAL_HOST)
+
+bool hV_HAL_Trace_save(const char * fileName)
+{
+    FILE * file = fopen(fileName, "w");
+    if (file == 0)
+    {
+        return false;
+    }
+
+    uint32_t first = (h_traceCount > TRACE_SIZE) ? h_traceCount - TRACE_SIZE : 0;
+
+    fprintf(file, "time,event,argument\n");
+    for (uint32_t index = first; index < h_traceCount; index += 1)
+    {
+        trace_t & trace = h_traceBuffer[index % TRACE_SIZE];
+        fprintf(file, "%u,%s,0x%x\n", trace.time, h_traceNames[trace.event], trace.argument);
+    }
+    fclose(file);
+    return true;
+}
+
+#endif // hV_HAL_HOST
+
+#endif // TRACE_MODE
+//
+// === End of Trace section
+//
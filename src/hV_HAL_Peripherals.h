@@ -38,6 +38,17 @@
 ///
 #define hV_HAL_PERIPHERALS_RELEASE 812
 
+#if defined(hV_HAL_HOST)
+
+///
+/// @brief Host back-end
+/// @details Arduino SDK subset for Linux, with recorder of SPI, GPIO and Wire traffic
+/// @see hV_HAL_Host.h
+///
+#include "hV_HAL_Host.h"
+
+#else
+
 ///
 /// @brief SDK library
 /// @see References
@@ -52,6 +63,8 @@
 #include <SPI.h>
 #include <Wire.h>
 
+#endif // hV_HAL_HOST
+
 ///
 /// @brief Other libraries
 ///
@@ -59,6 +72,11 @@
 #include <stdio.h>
 #include <stdarg.h>
 
+///
+/// @brief Options
+///
+#include "hV_List_Options.h"
+
 #define mySerial Serial
 
 ///
@@ -179,6 +197,85 @@ void hV_HAL_Wire_transfer(uint8_t address, uint8_t * dataWrite, size_t sizeWrite
 
 /// @}
 
+///
+/// @name Trace
+/// @details Events are recorded into a static ring buffer of TRACE_SIZE events,
+/// with time in us, event and 32-bit argument
+/// @n Trace points are removed at compilation unless TRACE_MODE is USE_TRACE_RING,
+/// and events are selected at compilation by TRACE_MASK
+///
+/// @{
+
+#define TRACE_SET_POINT 0 ///< s_setPoint(), argument = x << 16 | y
+#define TRACE_FLUSH_BEGIN 1 ///< s_flush() start, argument = update mode
+#define TRACE_FLUSH_END 2 ///< s_flush() end, argument = duration in us
+#define TRACE_SEND_INDEX 3 ///< b_sendIndexData(), argument = index << 24 | size
+#define TRACE_WAIT_BUSY 4 ///< b_waitBusy() end, argument = duration in us
+#define TRACE_TOUCH 5 ///< s_getRawTouch(), argument = event << 24 | x << 12 | y
+
+///
+/// @brief Trace event
+///
+struct trace_t
+{
+    uint32_t time; ///< time in us
+    uint8_t event; ///< TRACE_SET_POINT to TRACE_TOUCH
+    uint32_t argument; ///< argument
+};
+
+#if (TRACE_MODE == USE_TRACE_RING)
+
+///
+/// @brief Add an event to the ring buffer
+/// @param event event
+/// @param argument argument
+/// @note Use the macro hV_HAL_TRACE() for trace points
+///
+void hV_HAL_Trace_add(uint8_t event, uint32_t argument);
+
+///
+/// @brief Number of events recorded
+/// @return number of events since last clear, including overwritten ones
+///
+uint32_t hV_HAL_Trace_getCount();
+
+///
+/// @brief Clear the ring buffer
+///
+void hV_HAL_Trace_clear();
+
+///
+/// @brief Dump the ring buffer on mySerial
+/// @note Columns are time in us, event and argument, oldest first
+///
+void hV_HAL_Trace_dump();
+
+#if defined(hV_HAL_HOST)
+
+///
+/// @brief Dump the ring buffer into a file, host only
+/// @param fileName name of the file
+/// @return true if successful, false otherwise
+///
+bool hV_HAL_Trace_save(const char * fileName);
+
+#endif // hV_HAL_HOST
+
+///
+/// @brief Trace point
+/// @param event event
+/// @param argument argument, not evaluated when the event is not selected
+///
+#define hV_HAL_TRACE(event, argument) do { if ((TRACE_MASK >> (event)) & 0x01) { hV_HAL_Trace_add(event, argument); } } while (0)
+
+#else
+
+#define hV_HAL_TRACE(event, argument) do { } while (0)
+
+#endif // TRACE_MODE
+
+/// @}
+
 ///
 /// @name Miscellaneous
 /// @details Patches for implementations on some platforms
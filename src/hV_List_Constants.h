@@ -68,6 +68,57 @@
 #define UPDATE_GLOBAL 0x01 ///< Global update, default
 #define UPDATE_FAST 0x02 ///< Fast update
 #define UPDATE_PARTIAL 0x03 ///< Partial update, deprecated
+#define UPDATE_UNCHANGED 0x04 ///< No update, frame unchanged since last flush
+/// @}
+
+///
+/// @name Phases of flush for statistics
+/// @note Numbers are sequential and exclusive
+/// @{
+#define PHASE_RESUME 0 ///< resume()
+#define PHASE_INITIAL 1 ///< COG initial
+#define PHASE_SEND_IMAGE 2 ///< COG send image data
+#define PHASE_UPDATE 3 ///< COG update
+#define PHASE_POWER_OFF 4 ///< COG power off
+#define PHASE_WAIT_BUSY 5 ///< Cumulated time in b_waitBusy(), across phases
+#define PHASE_FLUSH 6 ///< Whole flush
+#define PHASE_NUMBER 7 ///< Number of phases
+/// @}
+
+///
+/// @name Stages of begin for profile
+/// @note Numbers are sequential and exclusive
+/// @{
+#define STAGE_CONFIGURATION 0 ///< Checks, board and sizes
+#define STAGE_REPORT 1 ///< Report on serial console
+#define STAGE_FRAME_BUFFER 2 ///< Frame-buffer allocation
+#define STAGE_RESET 3 ///< GPIO and reset
+#define STAGE_OTP 4 ///< OTP read and reset
+#define STAGE_SPI 5 ///< SPI start
+#define STAGE_FONTS 6 ///< Fonts and orientation
+#define STAGE_TOUCH 7 ///< Touch reset and configuration
+#define STAGE_BEGIN 8 ///< Whole begin()
+#define STAGE_NUMBER 9 ///< Number of stages
+/// @}
+
+///
+/// @name Layouts of image for frame-buffer export and import
+/// @note Numbers are sequential and exclusive
+/// @{
+#define IMAGE_NATIVE 0 ///< Panel-native layout, same as one page of the frame-buffer
+#define IMAGE_LOGICAL 1 ///< Logical layout, with current orientation
+/// @}
+
+///
+/// @name Raster operations for drawBitmap()
+/// @note Numbers are sequential and exclusive
+/// @n Bitmap bit 1 = black, 0 = white
+/// @{
+#define BITMAP_COPY 0 ///< Bitmap replaces the frame-buffer
+#define BITMAP_OR 1 ///< Black points of the bitmap added
+#define BITMAP_AND 2 ///< White points of the bitmap added
+#define BITMAP_XOR 3 ///< Black points of the bitmap inverted
+#define BITMAP_NOT 4 ///< Inverted bitmap replaces the frame-buffer
 /// @}
 
 ///
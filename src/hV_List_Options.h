@@ -15,8 +15,9 @@
 /// * 9. Set GPIO expander mode, not implemented
 /// * 10. String object for basic edition
 /// * 11. Set storage mode, not implemented
-/// * 12. Set debug options, not implemented
+/// * 12. Set debug options, trace
 /// * 13. Select EXT board
+/// * 14. Graphics options
 ///
 /// @author Rei Vilo
 /// @date 21 Jan 2025
@@ -94,6 +95,17 @@
 #define MAX_FONT_SIZE 64
 #endif
 
+///
+/// @brief Size of the glyph cache, in bytes
+/// @details Rotated characters of the selected font for the current orientation,
+/// allocated on first use
+/// * 0: no cache
+/// * 4608: ASCII 32..127 for all Terminal fonts, default
+///
+#ifndef GLYPH_CACHE_SIZE
+#define GLYPH_CACHE_SIZE 4608
+#endif // GLYPH_CACHE_SIZE
+
 ///
 /// @name 5- Set SRAM memory
 /// @details From internal MCU or external SPI
@@ -201,6 +213,24 @@
 /// * Commercial edition: option
 /// * Viewer edition: option
 ///
+/// @note Trace records events into a ring buffer, see hV_HAL_Trace_add()
+/// @n Without trace, the trace points are removed at compilation
+/// @{
+#define USE_TRACE_NONE 0 ///< No trace
+#define USE_TRACE_RING 1 ///< Trace into a ring buffer
+
+#ifndef TRACE_MODE
+#define TRACE_MODE USE_TRACE_NONE ///< Selected option
+#endif // TRACE_MODE
+
+#ifndef TRACE_SIZE
+#define TRACE_SIZE 256 ///< Number of events in the ring buffer
+#endif // TRACE_SIZE
+
+#ifndef TRACE_MASK
+#define TRACE_MASK 0xff ///< Selected events, one bit per event
+#endif // TRACE_MASK
+/// @}
 
 ///
 /// @name 13- EXT boards
@@ -216,5 +246,14 @@
 #define USE_EXT_BOARD BOARD_EXT3 ///< Selected board
 /// @}
 
+///
+/// @name 14- Graphics options
+///
+/// @{
+#ifndef CLIP_DEPTH
+#define CLIP_DEPTH 4 ///< Levels of pushClip()
+#endif // CLIP_DEPTH
+/// @}
+
 #endif // hV_LIST_OPTIONS_RELEASE
 
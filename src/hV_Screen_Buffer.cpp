@@ -21,6 +21,14 @@
 // Release 703: Improved orientation function
 // Release 801: Improved functions names consistency
 // Release 805: Added large variant for gText()
+// Release 820: Added fill of rectangle for screens
+// Release 820: Added runs for horizontal and vertical lines
+// Release 820: Added scanline fill for triangles
+// Release 820: Added spans for circles and ellipses
+// Release 820: Added character utility for gText()
+// Release 820: Added scale 2..8 for gTextLarge()
+// Release 820: Added clip rectangle and stack
+// Release 820: Added bitmap with raster operations
 //
 
 // Library header
@@ -35,6 +43,12 @@ hV_Screen_Buffer::hV_Screen_Buffer()
     f_fontSolid = true;
     f_fontSpaceX = 1;
     v_penSolid = false;
+
+    v_clipX1 = 0; // no point before begin()
+    v_clipY1 = 0;
+    v_clipX2 = 0;
+    v_clipY2 = 0;
+    v_clipDepth = 0;
 }
 
 void hV_Screen_Buffer::begin()
@@ -46,11 +60,18 @@ void hV_Screen_Buffer::clear(uint16_t colour)
 {
     uint8_t oldOrientation = v_orientation;
     bool oldPenSolid = v_penSolid;
+    uint16_t oldClip[4] = { v_clipX1, v_clipY1, v_clipX2, v_clipY2 };
+    uint8_t oldClipDepth = v_clipDepth; // same orientation on return, stack kept
     setOrientation(0);
     setPenSolid();
     rectangle(0, 0, screenSizeX() - 1, screenSizeY() - 1, colour);
     setOrientation(oldOrientation);
     setPenSolid(oldPenSolid);
+    v_clipX1 = oldClip[0];
+    v_clipY1 = oldClip[1];
+    v_clipX2 = oldClip[2];
+    v_clipY2 = oldClip[3];
+    v_clipDepth = oldClipDepth;
 }
 
 void hV_Screen_Buffer::flush()
@@ -90,6 +111,10 @@ void hV_Screen_Buffer::setOrientation(uint8_t orientation)
             s_setOrientation(v_orientation);
             break;
     }
+
+    // Saved clip rectangles belong to the previous orientation
+    v_clipDepth = 0;
+    resetClip();
 }
 
 uint8_t hV_Screen_Buffer::getOrientation()
@@ -149,6 +174,11 @@ uint8_t hV_Screen_Buffer::screenColourBits()
 
 void hV_Screen_Buffer::circle(uint16_t x0, uint16_t y0, uint16_t radius, uint16_t colour)
 {
+    if (s_isClipped((int32_t)x0 - radius, (int32_t)y0 - radius, (int32_t)x0 + radius, (int32_t)y0 + radius))
+    {
+        return;
+    }
+
     int16_t f = 1 - radius;
     int16_t ddF_x = 1;
     int16_t ddF_y = -2 * radius;
@@ -157,10 +187,10 @@ void hV_Screen_Buffer::circle(uint16_t x0, uint16_t y0, uint16_t radius, uint16_
 
     if (v_penSolid == false)
     {
-        point(x0, y0 + radius, colour);
-        point(x0, y0 - radius, colour);
-        point(x0 + radius, y0, colour);
-        point(x0 - radius, y0, colour);
+        s_setPoint(x0, y0 + radius, colour);
+        s_setPoint(x0, y0 - radius, colour);
+        s_setPoint(x0 + radius, y0, colour);
+        s_setPoint(x0 - radius, y0, colour);
 
         while (x < y)
         {
@@ -175,22 +205,61 @@ void hV_Screen_Buffer::circle(uint16_t x0, uint16_t y0, uint16_t radius, uint16_
             ddF_x += 2;
             f += ddF_x;
 
-            point(x0 + x, y0 + y, colour);
-            point(x0 - x, y0 + y, colour);
-            point(x0 + x, y0 - y, colour);
-            point(x0 - x, y0 - y, colour);
-            point(x0 + y, y0 + x, colour);
-            point(x0 - y, y0 + x, colour);
-            point(x0 + y, y0 - x, colour);
-            point(x0 - y, y0 - x, colour);
+            s_setPoint(x0 + x, y0 + y, colour);
+            s_setPoint(x0 - x, y0 + y, colour);
+            s_setPoint(x0 + x, y0 - y, colour);
+            s_setPoint(x0 - x, y0 - y, colour);
+            s_setPoint(x0 + y, y0 + x, colour);
+            s_setPoint(x0 - y, y0 + x, colour);
+            s_setPoint(x0 + y, y0 - x, colour);
+            s_setPoint(x0 - y, y0 - x, colour);
         }
     }
     else
     {
+        // First walk for the last point, the inner square
+        int16_t lastX = 0;
+        int16_t lastY = radius;
+        int16_t firstY = radius;
+
+        while (lastX < lastY)
+        {
+            if (f >= 0)
+            {
+                lastY--;
+                ddF_y += 2;
+                f += ddF_y;
+            }
+
+            lastX++;
+            ddF_x += 2;
+            f += ddF_x;
+
+            if (lastX == 1)
+            {
+                firstY = lastY;
+            }
+        }
+
+        // Second walk, one span per row
+        // Rows y0 +/- x span +/- y, rows y0 +/- y span +/- x once y is left,
+        // rows up to y0 +/- lastY include the inner square
+        f = 1 - radius;
+        ddF_x = 1;
+        ddF_y = -2 * radius;
+
+        s_fillSpan(x0 - max(firstY, lastX), x0 + max(firstY, lastX), y0, colour);
+
         while (x < y)
         {
             if (f >= 0)
             {
+                if ((x > 0) and (y > lastX))
+                {
+                    s_fillSpan(x0 - x, x0 + x, y0 - y, colour);
+                    s_fillSpan(x0 - x, x0 + x, y0 + y, colour);
+                }
+
                 y--;
                 ddF_y += 2;
                 f += ddF_y;
@@ -200,15 +269,82 @@ void hV_Screen_Buffer::circle(uint16_t x0, uint16_t y0, uint16_t radius, uint16_
             ddF_x += 2;
             f += ddF_x;
 
-            line(x0 + x, y0 + y, x0 - x, y0 + y, colour); // bottom
-            line(x0 + x, y0 - y, x0 - x, y0 - y, colour); // top
-            line(x0 + y, y0 - x, x0 + y, y0 + x, colour); // right
-            line(x0 - y, y0 - x, x0 - y, y0 + x, colour); // left
+            int16_t span = (x <= lastY) ? max(y, lastX) : y;
+            s_fillSpan(x0 - span, x0 + span, y0 - x, colour);
+            s_fillSpan(x0 - span, x0 + span, y0 + x, colour);
         }
+    }
+}
 
-        setPenSolid(true);
-        rectangle(x0 - x, y0 - y, x0 + x, y0 + y, colour);
+void hV_Screen_Buffer::ellipse(uint16_t x0, uint16_t y0, uint16_t radiusX, uint16_t radiusY, uint16_t colour)
+{
+    if (s_isClipped((int32_t)x0 - radiusX, (int32_t)y0 - radiusY, (int32_t)x0 + radiusX, (int32_t)y0 + radiusY))
+    {
+        return;
     }
+
+    // Walk the quadrant from (-radiusX, 0) to (0, radiusY)
+    int32_t x = -(int32_t)radiusX;
+    int32_t y = 0;
+    int32_t squareX = (int32_t)radiusX * radiusX;
+    int32_t squareY = (int32_t)radiusY * radiusY;
+    int32_t error = x * (2 * squareY + x) + squareY;
+    int32_t error2;
+    int32_t lastY = -1;
+
+    do
+    {
+        if (v_penSolid == false)
+        {
+            s_setPoint(x0 - x, y0 + y, colour);
+            s_setPoint(x0 + x, y0 + y, colour);
+            s_setPoint(x0 + x, y0 - y, colour);
+            s_setPoint(x0 - x, y0 - y, colour);
+        }
+        else if (y != lastY) // first point of the row is the widest
+        {
+            s_fillSpan(x0 + x, x0 - x, y0 - y, colour);
+            if (y > 0)
+            {
+                s_fillSpan(x0 + x, x0 - x, y0 + y, colour);
+            }
+            lastY = y;
+        }
+
+        error2 = 2 * error;
+        if (error2 >= (x * 2 + 1) * squareY)
+        {
+            x++;
+            error += (x * 2 + 1) * squareY;
+        }
+        if (error2 <= (y * 2 + 1) * squareX)
+        {
+            y++;
+            error += (y * 2 + 1) * squareX;
+        }
+    }
+    while (x <= 0);
+
+    // Tip of flat ellipses
+    while (y < radiusY)
+    {
+        y++;
+        if (v_penSolid == false)
+        {
+            s_setPoint(x0, y0 + y, colour);
+            s_setPoint(x0, y0 - y, colour);
+        }
+        else
+        {
+            s_fillSpan(x0, x0, y0 - y, colour);
+            s_fillSpan(x0, x0, y0 + y, colour);
+        }
+    }
+}
+
+void hV_Screen_Buffer::dEllipse(uint16_t x0, uint16_t y0, uint16_t dx, uint16_t dy, uint16_t colour)
+{
+    ellipse(x0 + dx / 2, y0 + dy / 2, dx / 2, dy / 2, colour);
 }
 
 void hV_Screen_Buffer::dLine(uint16_t x0, uint16_t y0, uint16_t dx, uint16_t dy, uint16_t colour)
@@ -228,10 +364,7 @@ void hV_Screen_Buffer::line(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2,
         {
             hV_HAL_swap(y1, y2);
         }
-        for (uint16_t y = y1; y <= y2; y++)
-        {
-            s_setPoint(x1, y, colour);
-        }
+        s_fillRectangle(x1, y1, x1, y2, colour); // vertical run
     }
     else if (y1 == y2)
     {
@@ -239,10 +372,11 @@ void hV_Screen_Buffer::line(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2,
         {
             hV_HAL_swap(x1, x2);
         }
-        for (uint16_t x = x1; x <= x2; x++)
-        {
-            s_setPoint(x, y1, colour);
-        }
+        s_fillRectangle(x1, y1, x2, y1, colour); // horizontal run
+    }
+    else if (s_isClipped(hV_HAL_min(x1, x2), hV_HAL_min(y1, y2), hV_HAL_max(x1, x2), hV_HAL_max(y1, y2)))
+    {
+        return;
     }
     else
     {
@@ -309,6 +443,129 @@ void hV_Screen_Buffer::point(uint16_t x1, uint16_t y1, uint16_t colour)
     s_setPoint(x1, y1, colour);
 }
 
+void hV_Screen_Buffer::drawBitmap(uint16_t x0, uint16_t y0, const uint8_t * bitmap, uint16_t sizeX, uint16_t sizeY, uint8_t operation)
+{
+    // Coordinates beyond 0x7fff are negative, as wrapped by uint16_t arithmetic
+    if ((sizeX == 0) or (sizeY == 0) or s_isClipped((int16_t)x0, (int16_t)y0, (int16_t)x0 + sizeX - 1, (int16_t)y0 + sizeY - 1))
+    {
+        return;
+    }
+
+    uint16_t bytesX = (sizeX + 7) / 8; // bytes per row
+    bool flag;
+
+    for (uint16_t y = 0; y < sizeY; y += 1)
+    {
+        for (uint16_t x = 0; x < sizeX; x += 1)
+        {
+            bool source = bitRead(bitmap[y * bytesX + x / 8], 7 - x % 8);
+            bool target = (s_getPoint(x0 + x, y0 + y) == myColours.black);
+
+            switch (operation)
+            {
+                case BITMAP_OR:
+
+                    flag = target or source;
+                    break;
+
+                case BITMAP_AND:
+
+                    flag = target and source;
+                    break;
+
+                case BITMAP_XOR:
+
+                    flag = target xor source;
+                    break;
+
+                case BITMAP_NOT:
+
+                    flag = not source;
+                    break;
+
+                default: // BITMAP_COPY
+
+                    flag = source;
+                    break;
+            }
+            point(x0 + x, y0 + y, (flag) ? myColours.black : myColours.white);
+        }
+    }
+}
+
+void hV_Screen_Buffer::setClip(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
+{
+    if (x1 > x2)
+    {
+        hV_HAL_swap(x1, x2);
+    }
+    if (y1 > y2)
+    {
+        hV_HAL_swap(y1, y2);
+    }
+
+    // Last point excluded
+    uint16_t sizeX = screenSizeX();
+    uint16_t sizeY = screenSizeY();
+
+    v_clipX2 = hV_HAL_min((uint32_t)x2 + 1, (uint32_t)sizeX);
+    v_clipY2 = hV_HAL_min((uint32_t)y2 + 1, (uint32_t)sizeY);
+    v_clipX1 = hV_HAL_min(x1, v_clipX2);
+    v_clipY1 = hV_HAL_min(y1, v_clipY2);
+}
+
+void hV_Screen_Buffer::resetClip()
+{
+    v_clipX1 = 0;
+    v_clipY1 = 0;
+    v_clipX2 = screenSizeX();
+    v_clipY2 = screenSizeY();
+}
+
+bool hV_Screen_Buffer::pushClip(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
+{
+    if (v_clipDepth >= CLIP_DEPTH)
+    {
+        return RESULT_ERROR;
+    }
+
+    uint16_t oldX1 = v_clipX1;
+    uint16_t oldY1 = v_clipY1;
+    uint16_t oldX2 = v_clipX2;
+    uint16_t oldY2 = v_clipY2;
+
+    v_clipStack[v_clipDepth][0] = oldX1;
+    v_clipStack[v_clipDepth][1] = oldY1;
+    v_clipStack[v_clipDepth][2] = oldX2;
+    v_clipStack[v_clipDepth][3] = oldY2;
+    v_clipDepth += 1;
+
+    // Intersection with previous clip rectangle
+    setClip(x1, y1, x2, y2);
+    v_clipX2 = hV_HAL_min(v_clipX2, oldX2);
+    v_clipY2 = hV_HAL_min(v_clipY2, oldY2);
+    v_clipX1 = hV_HAL_min(hV_HAL_max(v_clipX1, oldX1), v_clipX2);
+    v_clipY1 = hV_HAL_min(hV_HAL_max(v_clipY1, oldY1), v_clipY2);
+
+    return RESULT_SUCCESS;
+}
+
+bool hV_Screen_Buffer::popClip()
+{
+    if (v_clipDepth == 0)
+    {
+        return RESULT_ERROR;
+    }
+
+    v_clipDepth -= 1;
+    v_clipX1 = v_clipStack[v_clipDepth][0];
+    v_clipY1 = v_clipStack[v_clipDepth][1];
+    v_clipX2 = v_clipStack[v_clipDepth][2];
+    v_clipY2 = v_clipStack[v_clipDepth][3];
+
+    return RESULT_SUCCESS;
+}
+
 void hV_Screen_Buffer::rectangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t colour)
 {
     if (v_penSolid == false)
@@ -328,22 +585,48 @@ void hV_Screen_Buffer::rectangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t
         {
             hV_HAL_swap(y1, y2);
         }
-        for (uint16_t x = x1; x <= x2; x++)
+        s_fillRectangle(x1, y1, x2, y2, colour);
+    }
+}
+
+void hV_Screen_Buffer::s_fillRectangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t colour)
+{
+    if (s_isClipped(x1, y1, x2, y2))
+    {
+        return;
+    }
+
+    // Clip
+    x1 = hV_HAL_max(x1, v_clipX1);
+    y1 = hV_HAL_max(y1, v_clipY1);
+    x2 = hV_HAL_min(x2, (uint16_t)(v_clipX2 - 1));
+    y2 = hV_HAL_min(y2, (uint16_t)(v_clipY2 - 1));
+
+    for (uint16_t x = x1; x <= x2; x++)
+    {
+        for (uint16_t y = y1; y <= y2; y++)
         {
-            for (uint16_t y = y1; y <= y2; y++)
-            {
-                s_setPoint(x, y, colour);
-            }
+            s_setPoint(x, y, colour);
         }
     }
 }
 
+void hV_Screen_Buffer::s_fillSpan(int32_t x1, int32_t x2, int32_t y1, uint16_t colour)
+{
+    if (s_isClipped(x1, y1, x2, y1))
+    {
+        return;
+    }
+
+    s_fillRectangle(hV_HAL_max(x1, (int32_t)v_clipX1), y1, hV_HAL_min(x2, (int32_t)v_clipX2 - 1), y1, colour);
+}
+
 void hV_Screen_Buffer::dRectangle(uint16_t x0, uint16_t y0, uint16_t dx, uint16_t dy, uint16_t colour)
 {
     rectangle(x0, y0, x0 + dx - 1, y0 + dy - 1, colour);
 }
 
-void hV_Screen_Buffer::s_triangleArea(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, uint16_t colour)
+void hV_Screen_Buffer::s_triangleArea(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, uint16_t colour, uint16_t & baseX1, uint16_t & baseX2)
 {
     int16_t wx1 = (int16_t)x1;
     int16_t wy1 = (int16_t)y1;
@@ -386,9 +669,25 @@ void hV_Screen_Buffer::s_triangleArea(uint16_t x1, uint16_t y1, uint16_t x2, uin
     int16_t e1 = 2 * dy1 - dx1;
     int16_t e2 = 2 * dy2 - dx2;
 
+    // Span of the current row, both edges on the same row
+    int16_t rowY = wy1;
+    int16_t rowX1 = wx1;
+    int16_t rowX2 = wx1;
+
     for (int i = 0; i <= dx1; i++)
     {
-        line(wx4, wy4, wx5, wy5, colour);
+        if (wy4 != rowY)
+        {
+            s_fillRectangle(rowX1, rowY, rowX2, rowY, colour);
+            rowY = wy4;
+            rowX1 = hV_HAL_min(wx4, wx5);
+            rowX2 = hV_HAL_max(wx4, wx5);
+        }
+        else
+        {
+            rowX1 = hV_HAL_min(rowX1, hV_HAL_min(wx4, wx5));
+            rowX2 = hV_HAL_max(rowX2, hV_HAL_max(wx4, wx5));
+        }
 
         while (e1 >= 0)
         {
@@ -441,6 +740,10 @@ void hV_Screen_Buffer::s_triangleArea(uint16_t x1, uint16_t y1, uint16_t x2, uin
             e2 = e2 + 2 * dy2;
         }
     }
+
+    // Base row left to the caller
+    baseX1 = rowX1;
+    baseX2 = rowX2;
 }
 
 void hV_Screen_Buffer::triangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, uint16_t colour)
@@ -457,6 +760,10 @@ void hV_Screen_Buffer::triangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t
     {
         line(x1, y1, x2, y2, colour);
     }
+    else if (s_isClipped(hV_HAL_min(x1, hV_HAL_min(x2, x3)), hV_HAL_min(y1, hV_HAL_min(y2, y3)), hV_HAL_max(x1, hV_HAL_max(x2, x3)), hV_HAL_max(y1, hV_HAL_max(y2, y3))))
+    {
+        return;
+    }
     else if (v_penSolid)
     {
         bool b = true;
@@ -480,36 +787,31 @@ void hV_Screen_Buffer::triangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t
             }
         }
 
+        uint16_t baseX1, baseX2;
+
         if (y2 == y3)
         {
-            s_triangleArea(x1, y1, x2, y2, x3, y3, colour);
+            s_triangleArea(x1, y1, x2, y2, x3, y3, colour, baseX1, baseX2);
         }
         else if (y1 == y2)
         {
-            s_triangleArea(x3, y3, x1, y1, x2, y2, colour);
+            s_triangleArea(x3, y3, x1, y1, x2, y2, colour, baseX1, baseX2);
         }
         else
         {
             uint16_t x4 = (uint16_t)((int32_t)x1 + (y2 - y1) * (x3 - x1) / (y3 - y1));
             uint16_t y4 = y2;
+            uint16_t otherX1, otherX2;
 
-            s_triangleArea(x1, y1, x2, y2, x4, y4, colour);
-
-#if defined(ESP8266)
-            delay(1);
-#else
-            delayMicroseconds(1000); // delay(1);
-#endif // ESP8266
-
-            delayMicroseconds(1000); // delay(1);
-            s_triangleArea(x3, y3, x2, y2, x4, y4, colour);
-
-#if defined(ESP8266)
-            delay(1);
-#else
-            delayMicroseconds(1000); // delay(1);
-#endif // ESP8266
+            // Two areas sharing the row y2
+            s_triangleArea(x1, y1, x2, y2, x4, y4, colour, baseX1, baseX2);
+            s_triangleArea(x3, y3, x2, y2, x4, y4, colour, otherX1, otherX2);
+            baseX1 = hV_HAL_min(baseX1, otherX1);
+            baseX2 = hV_HAL_max(baseX2, otherX2);
         }
+
+        // Base row, drawn once
+        s_fillRectangle(baseX1, y2, baseX2, y2, colour);
     }
     else
     {
@@ -592,342 +894,126 @@ uint8_t hV_Screen_Buffer::s_getCharacter(uint8_t character, uint8_t index)
     return f_getCharacter(character, index);
 }
 
-void hV_Screen_Buffer::gText(uint16_t x0, uint16_t y0,
-                             String text,
-                             uint16_t textColour,
-                             uint16_t backColour)
+void hV_Screen_Buffer::s_drawCharacter(uint16_t x0, uint16_t y0, uint8_t character, uint16_t textColour, uint16_t backColour)
 {
 #if (FONT_MODE == USE_FONT_TERMINAL)
 
-    uint8_t c;
-    uint8_t line, line1, line2, line3;
-    uint16_t x, y;
-    uint8_t i, j, k;
+    uint8_t sizeX = f_font.maxWidth;
+    uint8_t sizeY = f_font.height;
+    uint8_t bytesY = (sizeY + 7) / 8; // bytes per column
+    uint8_t line;
 
-#if (MAX_FONT_SIZE > 0)
-
-    if (f_fontSize == 0)
+    // Coordinates beyond 0x7fff are negative, as wrapped by uint16_t arithmetic
+    if (s_isClipped((int16_t)x0, (int16_t)y0, (int16_t)x0 + sizeX - 1, (int16_t)y0 + sizeY - 1))
     {
-        for (k = 0; k < text.length(); k++)
-        {
-            c = text.charAt(k) - ' ';
-
-            for (i = 0; i < 6; i++)
-            {
-                line = f_getCharacter(c, i);
-
-                for (j = 0; j < 8; j++)
-                {
-                    if (bitRead(line, j))
-                    {
-                        point(x0 + 6 * k + i, y0 + j, textColour);
-                    }
-                    else if (f_fontSolid)
-                    {
-                        point(x0 + 6 * k + i, y0 + j, backColour);
-                    }
-                }
-            }
-        }
+        return;
     }
 
-#if (MAX_FONT_SIZE > 1)
-
-    else if (f_fontSize == 1)
+    for (uint8_t i = 0; i < sizeX; i++)
     {
-        for (k = 0; k < text.length(); k++)
+        for (uint8_t b = 0; b < bytesY; b++)
         {
-            c = text.charAt(k) - ' ';
+            line = f_getCharacter(character, bytesY * i + b);
 
-            for (i = 0; i < 8; i++)
+            for (uint8_t j = 0; (j < 8) and (8 * b + j < sizeY); j++)
             {
-                line = f_getCharacter(c, 2 * i);
-                line1 = f_getCharacter(c, 2 * i + 1);
-
-                for (j = 0; j < 8; j++)
+                if (bitRead(line, j))
                 {
-                    if (bitRead(line, j))
-                    {
-                        point(x0 + 8 * k + i, y0 + j, textColour);
-                    }
-                    else if (f_fontSolid)
-                    {
-                        point(x0 + 8 * k + i, y0 + j, backColour);
-                    }
-                    if (bitRead(line1, j))
-                    {
-                        point(x0 + 8 * k + i, y0 + 8 + j, textColour);
-                    }
-                    else if ((f_fontSolid) and (j < 4))
-                    {
-                        point(x0 + 8 * k + i, y0 + 8 + j, backColour);
-                    }
+                    point(x0 + i, y0 + 8 * b + j, textColour);
+                }
+                else if (f_fontSolid)
+                {
+                    point(x0 + i, y0 + 8 * b + j, backColour);
                 }
             }
         }
     }
 
-#if (MAX_FONT_SIZE > 2)
-
-    else if (f_fontSize == 2)
-    {
+#endif // FONT_MODE
+}
 
-        for (k = 0; k < text.length(); k++)
-        {
-            c = text.charAt(k) - ' ';
+void hV_Screen_Buffer::gText(uint16_t x0, uint16_t y0,
+                             String text,
+                             uint16_t textColour,
+                             uint16_t backColour)
+{
+#if (FONT_MODE == USE_FONT_TERMINAL)
 
-            for (i = 0; i < 12; i++)
-            {
-                line = f_getCharacter(c, 2 * i);
-                line1 = f_getCharacter(c, 2 * i + 1);
+#if (MAX_FONT_SIZE > 0)
 
-                for (j = 0; j < 8; j++)
-                {
-                    if (bitRead(line, j))
-                    {
-                        point(x0 + 12 * k + i, y0 + j, textColour);
-                    }
-                    else if (f_fontSolid)
-                    {
-                        point(x0 + 12 * k + i, y0 + j, backColour);
-                    }
-                    if (bitRead(line1, j))
-                    {
-                        point(x0 + 12 * k + i, y0 + 8 + j, textColour);
-                    }
-                    else if (f_fontSolid)
-                    {
-                        point(x0 + 12 * k + i, y0 + 8 + j, backColour);
-                    }
-                }
-            }
-        }
-    }
-#if (MAX_FONT_SIZE > 3)
+    uint8_t sizeX = f_font.maxWidth;
 
-    else if (f_fontSize == 3)
+    for (uint8_t k = 0; k < text.length(); k++)
     {
-        for (k = 0; k < text.length(); k++)
-        {
-            c = text.charAt(k) - ' ';
-            for (i = 0; i < 16; i++)
-            {
-                line = f_getCharacter(c, 3 * i);
-                line1 = f_getCharacter(c, 3 * i + 1);
-                line2 = f_getCharacter(c, 3 * i + 2);
-                for (j = 0; j < 8; j++)
-                {
-                    if (bitRead(line, j))
-                    {
-                        point(x0 + 16 * k + i, y0 + j, textColour);
-                    }
-                    else if (f_fontSolid)
-                    {
-                        point(x0 + 16 * k + i, y0 + j, backColour);
-                    }
-                    if (bitRead(line1, j))
-                    {
-                        point(x0 + 16 * k + i, y0 + 8 + j, textColour);
-                    }
-                    else if (f_fontSolid)
-                    {
-                        point(x0 + 16 * k + i, y0 + 8 + j, backColour);
-                    }
-                    if (bitRead(line2, j))
-                    {
-                        point(x0 + 16 * k + i, y0 + 16 + j, textColour);
-                    }
-                    else if (f_fontSolid)
-                    {
-                        point(x0 + 16 * k + i, y0 + 16 + j, backColour);
-                    }
-                }
-            }
-        }
+        s_drawCharacter(x0 + sizeX * k, y0, text.charAt(k) - ' ', textColour, backColour);
     }
-#endif // end MAX_FONT_SIZE > 3
-#endif // end MAX_FONT_SIZE > 2
-#endif // end MAX_FONT_SIZE > 1
+
 #endif // end MAX_FONT_SIZE > 0
 #endif // FONT_MODE
 }
 
-void hV_Screen_Buffer::gTextLarge(uint16_t x0, uint16_t y0,
-                                  String text,
-                                  uint16_t textColour,
-                                  uint16_t backColour)
+void hV_Screen_Buffer::s_drawCharacterScaled(uint16_t x0, uint16_t y0, uint8_t character, uint8_t scale, uint16_t textColour, uint16_t backColour)
 {
 #if (FONT_MODE == USE_FONT_TERMINAL)
 
-    uint8_t c;
-    uint8_t line, line1, line2, line3;
+    uint8_t sizeX = f_font.maxWidth;
+    uint8_t sizeY = f_font.height;
+    uint8_t bytesY = (sizeY + 7) / 8; // bytes per column
+    uint8_t line;
     uint16_t x, y;
-    uint8_t i, j, k;
-
-    uint8_t ix = 2;
-    uint8_t iy = 2;
-
-    bool oldPenSolid = v_penSolid;
-    setPenSolid(true);
-
-#if (MAX_FONT_SIZE > 0)
 
-    if (f_fontSize == 0)
+    // Coordinates beyond 0x7fff are negative, as wrapped by uint16_t arithmetic
+    if (s_isClipped((int16_t)x0, (int16_t)y0, (int16_t)x0 + sizeX * scale - 1, (int16_t)y0 + sizeY * scale - 1))
     {
-        for (k = 0; k < text.length(); k++)
-        {
-            x = x0 + 6 * k * ix;
-            y = y0;
-            c = text.charAt(k) - ' ';
-
-            for (i = 0; i < 6; i++)
-            {
-                line = f_getCharacter(c, i);
-
-                for (j = 0; j < 8; j++)
-                {
-                    if (bitRead(line, j))
-                    {
-                        dRectangle(x + i * ix, y + j * iy, ix, iy, textColour);
-                    }
-                    else if (f_fontSolid)
-                    {
-                        dRectangle(x + i * ix, y + j * iy, ix, iy, backColour);
-                    }
-                }
-            }
-        }
+        return;
     }
 
-#if (MAX_FONT_SIZE > 1)
-
-    else if (f_fontSize == 1)
+    for (uint8_t i = 0; i < sizeX; i++)
     {
-        for (k = 0; k < text.length(); k++)
+        x = x0 + i * scale;
+
+        for (uint8_t b = 0; b < bytesY; b++)
         {
-            x = x0 + 8 * k * ix;
-            y = y0;
-            c = text.charAt(k) - ' ';
+            line = f_getCharacter(character, bytesY * i + b);
 
-            for (i = 0; i < 8; i++)
+            for (uint8_t j = 0; (j < 8) and (8 * b + j < sizeY); j++)
             {
-                line = f_getCharacter(c, 2 * i);
-                line1 = f_getCharacter(c, 2 * i + 1);
+                y = y0 + (8 * b + j) * scale;
 
-                for (j = 0; j < 8; j++)
+                if (bitRead(line, j))
+                {
+                    s_fillRectangle(x, y, x + scale - 1, y + scale - 1, textColour);
+                }
+                else if (f_fontSolid)
                 {
-                    if (bitRead(line, j))
-                    {
-                        dRectangle(x + i * ix, y0 + j * iy, ix, iy, textColour);
-                    }
-                    else if (f_fontSolid)
-                    {
-                        dRectangle(x + i * ix, y0 + j * iy, ix, iy, backColour);
-                    }
-                    if (bitRead(line1, j))
-                    {
-                        dRectangle(x + i * ix, y0 + (8 + j) * iy, ix, iy, textColour);
-                    }
-                    else if ((f_fontSolid) and (j < 4))
-                    {
-                        dRectangle(x + i * ix, y0 + (8 + j) * iy, ix, iy, backColour);
-                    }
+                    s_fillRectangle(x, y, x + scale - 1, y + scale - 1, backColour);
                 }
             }
         }
     }
 
-#if (MAX_FONT_SIZE > 2)
-
-    else if (f_fontSize == 2)
-    {
-
-        for (k = 0; k < text.length(); k++)
-        {
-            x = x0 + 12 * k * ix;
-            y = y0;
-            c = text.charAt(k) - ' ';
+#endif // FONT_MODE
+}
 
-            for (i = 0; i < 12; i++)
-            {
-                line = f_getCharacter(c, 2 * i);
-                line1 = f_getCharacter(c, 2 * i + 1);
+void hV_Screen_Buffer::gTextLarge(uint16_t x0, uint16_t y0,
+                                  String text,
+                                  uint16_t textColour,
+                                  uint16_t backColour,
+                                  uint8_t scale)
+{
+#if (FONT_MODE == USE_FONT_TERMINAL)
 
-                for (j = 0; j < 8; j++)
-                {
-                    if (bitRead(line, j))
-                    {
-                        dRectangle(x + i * ix, y0 + j * iy, ix, iy, textColour);
-                    }
-                    else if (f_fontSolid)
-                    {
-                        dRectangle(x + i * ix, y0 + j * iy, ix, iy, backColour);
-                    }
-                    if (bitRead(line1, j))
-                    {
-                        dRectangle(x + i * ix, y0 + (8 + j) * iy, ix, iy, textColour);
-                    }
-                    else if (f_fontSolid)
-                    {
-                        dRectangle(x + i * ix, y0 + (8 + j) * iy, ix, iy, backColour);
-                    }
-                }
-            }
-        }
-    }
+#if (MAX_FONT_SIZE > 0)
 
-#if (MAX_FONT_SIZE > 3)
+    scale = checkRange(scale, 2, 8);
+    uint16_t sizeX = f_font.maxWidth * scale;
 
-    else if (f_fontSize == 3)
+    for (uint8_t k = 0; k < text.length(); k++)
     {
-        for (k = 0; k < text.length(); k++)
-        {
-            x = x0 + 16 * k * ix;
-            y = y0;
-            c = text.charAt(k) - ' ';
-
-            for (i = 0; i < 16; i++)
-            {
-                line = f_getCharacter(c, 3 * i);
-                line1 = f_getCharacter(c, 3 * i + 1);
-                line2 = f_getCharacter(c, 3 * i + 2);
-                for (j = 0; j < 8; j++)
-                {
-                    if (bitRead(line, j))
-                    {
-                        dRectangle(x + i * ix, y0 + j * iy, ix, iy, textColour);
-                    }
-                    else if (f_fontSolid)
-                    {
-                        dRectangle(x + i * ix, y0 + j * iy, ix, iy, backColour);
-                    }
-                    if (bitRead(line1, j))
-                    {
-                        dRectangle(x + i * ix, y0 + (8 + j) * iy, ix, iy, textColour);
-                    }
-                    else if (f_fontSolid)
-                    {
-                        dRectangle(x + i * ix, y0 + (8 + j) * iy, ix, iy, backColour);
-                    }
-                    if (bitRead(line2, j))
-                    {
-                        dRectangle(x + i * ix, y0 + (16 + j) * iy, ix, iy, textColour);
-                    }
-                    else if (f_fontSolid)
-                    {
-                        dRectangle(x + i * ix, y0 + (16 + j) * iy, ix, iy, backColour);
-                    }
-                }
-            }
-        }
+        s_drawCharacterScaled(x0 + sizeX * k, y0, text.charAt(k) - ' ', scale, textColour, backColour);
     }
-#endif // end MAX_FONT_SIZE > 3
-#endif // end MAX_FONT_SIZE > 2
-#endif // end MAX_FONT_SIZE > 1
-#endif // end MAX_FONT_SIZE > 0
-
-    setPenSolid(oldPenSolid);
 
+#endif // end MAX_FONT_SIZE > 0
 #endif // FONT_MODE
 }
 //
@@ -106,6 +106,7 @@ class hV_Screen_Buffer : protected hV_Font_Terminal
     /// * ORIENTATION_PORTRAIT = 6 = check portrait
     /// * ORIENTATION_LANDSCAPE = 7 = check landscape
     /// @note Run the Common_Orientation.ino example to identify the options
+    /// @note Resets the clip rectangle and empties the clip stack
     ///
     virtual void setOrientation(uint8_t orientation);
 
@@ -167,6 +168,32 @@ class hV_Screen_Buffer : protected hV_Font_Terminal
     ///
     virtual void circle(uint16_t x0, uint16_t y0, uint16_t radius, uint16_t colour);
 
+    ///
+    /// @brief Draw ellipse, center and radii
+    /// @param x0 center, point coordinate, x-axis
+    /// @param y0 center, point coordinate, y-axis
+    /// @param radiusX radius, x-axis
+    /// @param radiusY radius, y-axis
+    /// @param colour 16-bit colour
+    /// @note Solid ellipse is filled with one span per row
+    ///
+    /// @n @b More: @ref Coordinate, @ref Colour
+    ///
+    virtual void ellipse(uint16_t x0, uint16_t y0, uint16_t radiusX, uint16_t radiusY, uint16_t colour);
+
+    ///
+    /// @brief Draw ellipse, vector coordinates
+    /// @param x0 top left coordinate of the bounding box, x-axis
+    /// @param y0 top left coordinate of the bounding box, y-axis
+    /// @param dx length, x-axis
+    /// @param dy height, y-axis
+    /// @param colour 16-bit colour
+    /// @note Radii are dx / 2 and dy / 2
+    ///
+    /// @n @b More: @ref Coordinate, @ref Colour
+    ///
+    virtual void dEllipse(uint16_t x0, uint16_t y0, uint16_t dx, uint16_t dy, uint16_t colour);
+
     ///
     /// @brief Draw line, rectangle coordinates
     /// @param x1 top left coordinate, x-axis
@@ -246,6 +273,69 @@ class hV_Screen_Buffer : protected hV_Font_Terminal
     ///
     virtual void point(uint16_t x1, uint16_t y1, uint16_t colour);
 
+    ///
+    /// @brief Draw bitmap, 1 bit per pixel
+    /// @param x0 top left coordinate, x-axis
+    /// @param y0 top left coordinate, y-axis
+    /// @param bitmap rows of sizeX pixels, each row padded to a whole byte, first pixel = MSB, 1 = black
+    /// @param sizeX width of the bitmap, x-axis
+    /// @param sizeY height of the bitmap, y-axis
+    /// @param operation BITMAP_COPY, BITMAP_OR, BITMAP_AND, BITMAP_XOR or BITMAP_NOT, default = BITMAP_COPY
+    /// @note Same layout as IMAGE_LOGICAL and PBM binary P4
+    /// @n Default calls s_getPoint() and point() for each point, screens may provide a faster implementation
+    ///
+    /// @n @b More: @ref Coordinate
+    ///
+    virtual void drawBitmap(uint16_t x0, uint16_t y0, const uint8_t * bitmap, uint16_t sizeX, uint16_t sizeY, uint8_t operation = BITMAP_COPY);
+
+    /// @}
+
+    /// @name Clip
+    /// @details Graphics and text are drawn only within the clip rectangle
+    /// @n Primitives fully outside the clip rectangle are rejected,
+    /// others are clipped by lines and spans
+    /// @{
+
+    ///
+    /// @brief Set clip rectangle, rectangle coordinates
+    /// @param x1 top left coordinate, x-axis
+    /// @param y1 top left coordinate, y-axis
+    /// @param x2 bottom right coordinate, x-axis
+    /// @param y2 bottom right coordinate, y-axis
+    /// @note The clip rectangle is limited to the screen
+    /// @n setOrientation() resets the clip rectangle to the whole screen
+    ///
+    /// @n @b More: @ref Coordinate
+    ///
+    virtual void setClip(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2);
+
+    ///
+    /// @brief Reset clip rectangle to the whole screen
+    ///
+    virtual void resetClip();
+
+    ///
+    /// @brief Save the clip rectangle and restrict it, rectangle coordinates
+    /// @param x1 top left coordinate, x-axis
+    /// @param y1 top left coordinate, y-axis
+    /// @param x2 bottom right coordinate, x-axis
+    /// @param y2 bottom right coordinate, y-axis
+    /// @return RESULT_SUCCESS = false = success, RESULT_ERROR = true = error, stack full
+    /// @note The new clip rectangle is the intersection with the previous one
+    /// @n Up to CLIP_DEPTH levels
+    /// @n setOrientation() empties the stack, as the saved rectangles belong to the previous orientation
+    ///
+    /// @n @b More: @ref Coordinate
+    ///
+    virtual bool pushClip(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2);
+
+    ///
+    /// @brief Restore the clip rectangle saved by pushClip()
+    /// @return RESULT_SUCCESS = false = success, RESULT_ERROR = true = error, stack empty
+    /// @note setOrientation() empties the stack, clear() keeps it
+    ///
+    virtual bool popClip();
+
     /// @}
 
     /// @name Text
@@ -358,6 +448,7 @@ class hV_Screen_Buffer : protected hV_Font_Terminal
     /// @param text text string
     /// @param textColour 16-bit colour, default = white
     /// @param backColour 16-bit colour, default = black
+    /// @param scale integer scale, 2..8, default = 2
     /// @note Previously gText() with ix and iy
     ///
     /// @n @b More: @ref Colour, @ref Fonts, @ref Coordinate
@@ -365,7 +456,8 @@ class hV_Screen_Buffer : protected hV_Font_Terminal
     virtual void gTextLarge(uint16_t x0, uint16_t y0,
                             String text,
                             uint16_t textColour = myColours.black,
-                            uint16_t backColour = myColours.white);
+                            uint16_t backColour = myColours.white,
+                            uint8_t scale = 2);
     /// @}
 
     //
@@ -451,21 +543,54 @@ class hV_Screen_Buffer : protected hV_Font_Terminal
     ///
     virtual void s_setPoint(uint16_t x1, uint16_t y1, uint16_t colour) = 0; // compulsory
 
+    ///
+    /// @brief Get point
+    /// @param x1 x coordinate
+    /// @param y1 y coordinate
+    /// @return colour 16-bit colour
+    /// @n @b More: @ref Colour, @ref Coordinate
+    ///
+    virtual uint16_t s_getPoint(uint16_t x1, uint16_t y1) = 0; // compulsory
+
+    ///
+    /// @brief Fill a rectangle
+    /// @param x1 top left coordinate, x-axis
+    /// @param y1 top left coordinate, y-axis
+    /// @param x2 bottom right coordinate, x-axis, x2 >= x1
+    /// @param y2 bottom right coordinate, y-axis, y2 >= y1
+    /// @param colour 16-bit colour
+    /// @note Default clips to the clip rectangle and calls s_setPoint() for each point, screens may provide a faster implementation
+    ///
+    virtual void s_fillRectangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t colour);
+
+    ///
+    /// @brief Fill a span of a row, clipped to the clip rectangle
+    /// @param x1 first point, x-axis, may be negative
+    /// @param x2 last point, x-axis, x2 >= x1
+    /// @param y1 row, y-axis, may be negative
+    /// @param colour 16-bit colour
+    /// @note Used by circle() and ellipse(), calls s_fillRectangle()
+    ///
+    void s_fillSpan(int32_t x1, int32_t x2, int32_t y1, uint16_t colour);
+
     // Write and Read
 
     // Other functions
     // required by triangle()
     ///
-    /// @brief Triangle utility
-    /// @param x1 first point coordinate, x-axis
-    /// @param y1 first point coordinate, y-axis
+    /// @brief Triangle utility, scanline fill with one span per row
+    /// @param x1 apex coordinate, x-axis
+    /// @param y1 apex coordinate, y-axis
     /// @param x2 second point coordinate, x-axis
-    /// @param y2 second point coordinate, y-axis
+    /// @param y2 second point coordinate, y-axis, base row
     /// @param x3 third point coordinate, x-axis
-    /// @param y3 third point coordinate, y-axis
+    /// @param y3 third point coordinate, y-axis, y3 = y2
     /// @param colour 16-bit colour
+    /// @param[out] baseX1 first point of the base row, x-axis
+    /// @param[out] baseX2 last point of the base row, x-axis
+    /// @note The base row is not drawn, so two areas sharing it draw it once
     ///
-    void s_triangleArea(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, uint16_t colour);
+    void s_triangleArea(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, uint16_t colour, uint16_t & baseX1, uint16_t & baseX2);
 
     // required by gText()
     ///
@@ -476,6 +601,29 @@ class hV_Screen_Buffer : protected hV_Font_Terminal
     ///
     uint8_t s_getCharacter(uint8_t character, uint8_t index);
 
+    ///
+    /// @brief Draw a character of the selected font
+    /// @param x0 top left coordinate, x-axis
+    /// @param y0 top left coordinate, y-axis
+    /// @param character character index, 0 = space
+    /// @param textColour 16-bit colour
+    /// @param backColour 16-bit colour, only if font is solid
+    /// @note Default calls point() for each point, screens may provide a faster implementation
+    ///
+    virtual void s_drawCharacter(uint16_t x0, uint16_t y0, uint8_t character, uint16_t textColour, uint16_t backColour);
+
+    ///
+    /// @brief Draw a character of the selected font, scaled
+    /// @param x0 top left coordinate, x-axis
+    /// @param y0 top left coordinate, y-axis
+    /// @param character character index, 0 = space
+    /// @param scale integer scale, 2..8
+    /// @param textColour 16-bit colour
+    /// @param backColour 16-bit colour, only if font is solid
+    /// @note Default calls s_fillRectangle() for each point, screens may provide a faster implementation
+    ///
+    virtual void s_drawCharacterScaled(uint16_t x0, uint16_t y0, uint8_t character, uint8_t scale, uint16_t textColour, uint16_t backColour);
+
     uint8_t * s_newImage;
 
     // Variables provided by hV_Screen_Virtual
@@ -484,6 +632,24 @@ class hV_Screen_Buffer : protected hV_Font_Terminal
     uint8_t v_orientation, v_intensity;
     uint16_t v_screenColourBits;
 
+    // Clip, first point included, last point excluded, within the screen
+    uint16_t v_clipX1, v_clipY1, v_clipX2, v_clipY2;
+    uint16_t v_clipStack[CLIP_DEPTH][4];
+    uint8_t v_clipDepth;
+
+    ///
+    /// @brief Check a rectangle against the clip rectangle
+    /// @param x1 top left coordinate, x-axis
+    /// @param y1 top left coordinate, y-axis
+    /// @param x2 bottom right coordinate, x-axis, x2 >= x1
+    /// @param y2 bottom right coordinate, y-axis, y2 >= y1
+    /// @return true if the rectangle is fully outside the clip rectangle, or the clip rectangle is empty
+    ///
+    inline bool s_isClipped(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+    {
+        return (x2 < v_clipX1) or (x1 >= v_clipX2) or (y2 < v_clipY1) or (y1 >= v_clipY2) or (v_clipX1 == v_clipX2) or (v_clipY1 == v_clipY2);
+    }
+
     //
     // === Touch section
     //
@@ -16,6 +16,8 @@
 //
 // Release 700: Refactored screen and board functions
 // Release 803: Added types for string and frame-buffer
+// Release 820: Added running statistics
+// Release 820: Added memory footprint
 //
 
 // Library header
@@ -32,6 +34,11 @@ void delay_ms(uint32_t ms)
 char bufferIn[128];
 char bufferOut[128];
 
+uint32_t sizeSharedBuffers()
+{
+    return sizeof(bufferIn) + sizeof(bufferOut);
+}
+
 // Code
 // Utilities
 
@@ -225,3 +232,27 @@ uint32_t roundUp(uint32_t value, uint16_t modulo)
     return result;
 }
 
+void resetStatistics(statistics_t & statistics)
+{
+    statistics.count = 0;
+    statistics.minimum = 0;
+    statistics.maximum = 0;
+    statistics.mean = 0;
+    statistics.total = 0;
+}
+
+void updateStatistics(statistics_t & statistics, uint32_t value)
+{
+    if ((statistics.count == 0) or (value < statistics.minimum))
+    {
+        statistics.minimum = value;
+    }
+    if ((statistics.count == 0) or (value > statistics.maximum))
+    {
+        statistics.maximum = value;
+    }
+
+    statistics.count += 1;
+    statistics.total += value;
+    statistics.mean = (uint32_t)(statistics.total / statistics.count);
+}
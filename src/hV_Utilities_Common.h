@@ -153,4 +153,64 @@ uint32_t roundUp(uint32_t value, uint16_t modulo);
 
 /// @}
 
+///
+/// @name Statistics
+/// @brief Running minimum, maximum and mean
+/// @{
+
+///
+/// @brief Running statistics
+///
+struct statistics_t
+{
+    uint32_t count; ///< number of values
+    uint32_t minimum; ///< minimum value
+    uint32_t maximum; ///< maximum value
+    uint32_t mean; ///< mean value
+    uint64_t total; ///< sum of values
+};
+
+///
+/// @brief Reset statistics
+/// @param statistics statistics to reset
+///
+void resetStatistics(statistics_t & statistics);
+
+///
+/// @brief Add a value to statistics
+/// @param statistics statistics to update
+/// @param value value to add
+///
+void updateStatistics(statistics_t & statistics, uint32_t value);
+
+/// @}
+
+///
+/// @name Memory
+/// @brief Memory footprint
+/// @{
+
+///
+/// @brief Memory footprint, in bytes
+///
+struct memory_t
+{
+    uint32_t frameBuffer; ///< frame-buffer, heap
+    uint32_t glyphCache; ///< glyph cache, heap, allocated on first text, worst case
+    uint32_t object; ///< screen object, static, including OTP
+    uint32_t OTP; ///< OTP data, included in object
+    uint32_t buffers; ///< shared buffers, static
+    uint32_t fonts; ///< font tables, constant
+    uint32_t RAM; ///< frame-buffer + glyph cache + object + buffers
+    uint32_t flash; ///< fonts, constant, in flash on most MCUs
+};
+
+///
+/// @brief Size of the shared buffers
+/// @return size in bytes of the buffers used by formatString() and utf2iso()
+///
+uint32_t sizeSharedBuffers();
+
+/// @}
+
 #endif // hV_UTILITIES_RELEASE